@@ -56,9 +56,24 @@ template <typename T>
 class __meta__ { };    
 }
 
+// Descriptors are validated at compile time when constexpr functions with loops
+// are available (C++14)
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define FLECS_META_CONSTEXPR_PARSER
+#endif
+
+#ifdef FLECS_META_CONSTEXPR_PARSER
+#define ECS_META_CPP_CHECK(T, kind, descr)\
+static_assert(flecs::_::meta_count(kind, descr) >= 0,\
+    "invalid type descriptor for " #T);
+#else
+#define ECS_META_CPP_CHECK(T, kind, descr)
+#endif
+
 // Specialized C++ class that stores name and descriptor of type
 #define ECS_META_CPP(T, kind, descr);\
 namespace flecs {\
+ECS_META_CPP_CHECK(T, kind, descr)\
 template<>\
 class __meta__ <T> {\
 public:\
@@ -173,6 +188,246 @@ ECS_ENUM_BOOTSTRAP( ecs_type_kind_t, {
     EcsMapType
 });
 
+#ifdef FLECS_META_CONSTEXPR_PARSER
+
+// Compile time versions of the descriptor parser. These follow the same rules
+// as the runtime parser, so that errors in type descriptors are reported when
+// the code is compiled instead of when the type is registered. They only
+// validate: types are still registered by the runtime parser, as member
+// offsets can't be derived from a stringized descriptor.
+namespace flecs {
+namespace _ {
+
+constexpr bool meta_is_space(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || 
+        ch == '\v' || ch == '\f';
+}
+
+constexpr bool meta_is_alpha(char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+constexpr bool meta_is_digit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+constexpr bool meta_is_ident_start(char ch) {
+    return meta_is_alpha(ch) || ch == '_';
+}
+
+constexpr int32_t meta_skip_ws(const char *ptr, int32_t pos) {
+    while (meta_is_space(ptr[pos])) {
+        pos ++;
+    }
+    return pos;
+}
+
+constexpr bool meta_token_eq(
+    const char *ptr, int32_t start, int32_t end, const char *str) 
+{
+    int32_t i = 0;
+    for (; start + i < end; i ++) {
+        if (ptr[start + i] != str[i]) {
+            return false;
+        }
+    }
+    return str[i] == '\0';
+}
+
+// Returns position after identifier, or -1 if the identifier is invalid
+constexpr int32_t meta_parse_identifier(
+    const char *ptr, int32_t pos, bool allow_params) 
+{
+    pos = meta_skip_ws(ptr, pos);
+    if (!meta_is_ident_start(ptr[pos])) {
+        return -1;
+    }
+
+    int32_t depth = 0;
+    char ch = 0;
+    while ((ch = ptr[pos])) {
+        if (ch == '(' || ch == '<') {
+            if (!allow_params) {
+                return -1;
+            }
+            depth ++;
+        } else if (ch == ')' || ch == '>') {
+            if (!depth) {
+                break;
+            }
+            depth --;
+        } else if (!depth && (meta_is_space(ch) || ch == ';' || ch == ',' ||
+            ch == '=' || ch == '}'))
+        {
+            break;
+        }
+        pos ++;
+    }
+
+    if (!ch || depth) {
+        return -1;
+    }
+
+    return pos;
+}
+
+// Parse member, returns position after member, 0 if the end of the descriptor
+// or ECS_PRIVATE was reached, or -1 if the member is invalid.
+constexpr int32_t meta_parse_member(const char *ptr, int32_t pos) {
+    pos = meta_skip_ws(ptr, pos);
+    if (ptr[pos] == '}') {
+        pos = meta_skip_ws(ptr, pos + 1);
+        return ptr[pos] ? -1 : 0;
+    }
+
+    int32_t start = meta_skip_ws(ptr, pos);
+    pos = meta_parse_identifier(ptr, start, true);
+    if (pos < 0) {
+        return -1;
+    }
+
+    if (meta_token_eq(ptr, start, pos, "ECS_PRIVATE")) {
+        return 0;
+    }
+
+    if (meta_token_eq(ptr, start, pos, "const")) {
+        pos = meta_parse_identifier(ptr, pos, true);
+        if (pos < 0) {
+            return -1;
+        }
+    }
+
+    pos = meta_skip_ws(ptr, pos);
+    if (ptr[pos] == '*') {
+        pos ++;
+    }
+
+    // Member name, may contain array size
+    start = meta_skip_ws(ptr, pos);
+    if (!meta_is_ident_start(ptr[start])) {
+        return -1;
+    }
+
+    pos = start;
+    while (meta_is_alpha(ptr[pos]) || meta_is_digit(ptr[pos]) || 
+        ptr[pos] == '_') 
+    {
+        pos ++;
+    }
+
+    pos = meta_skip_ws(ptr, pos);
+    if (ptr[pos] == '[') {
+        pos = meta_skip_ws(ptr, pos + 1);
+        if (!meta_is_digit(ptr[pos])) {
+            return -1;
+        }
+        while (meta_is_digit(ptr[pos]) || meta_is_alpha(ptr[pos])) {
+            pos ++;
+        }
+        pos = meta_skip_ws(ptr, pos);
+        if (ptr[pos] != ']') {
+            return -1;
+        }
+        pos = meta_skip_ws(ptr, pos + 1);
+    }
+
+    if (ptr[pos] != ';') {
+        return -1;
+    }
+
+    return pos + 1;
+}
+
+// Parse constant, returns position after constant, 0 if the end of the 
+// descriptor was reached, or -1 if the constant is invalid.
+constexpr int32_t meta_parse_constant(const char *ptr, int32_t pos) {
+    pos = meta_skip_ws(ptr, pos);
+    if (ptr[pos] == '}') {
+        pos = meta_skip_ws(ptr, pos + 1);
+        return ptr[pos] ? -1 : 0;
+    }
+
+    pos = meta_parse_identifier(ptr, pos, false);
+    if (pos < 0) {
+        return -1;
+    }
+
+    pos = meta_skip_ws(ptr, pos);
+    if (ptr[pos] == '=') {
+        pos = meta_skip_ws(ptr, pos + 1);
+        if (ptr[pos] == '-') {
+            pos ++;
+        } else if (ptr[pos] == '0' && ptr[pos + 1] == 'x') {
+            pos += 2;
+        }
+
+        if (!meta_is_digit(ptr[pos])) {
+            return -1;
+        }
+
+        while (meta_is_digit(ptr[pos]) || meta_is_alpha(ptr[pos])) {
+            pos ++;
+        }
+
+        pos = meta_skip_ws(ptr, pos);
+    }
+
+    if (ptr[pos] == ',') {
+        return pos + 1;
+    } else if (ptr[pos] == '}') {
+        return pos;
+    }
+
+    return -1;
+}
+
+// Count members or constants in a descriptor. Returns -1 if the descriptor is
+// invalid.
+constexpr int32_t meta_count(ecs_type_kind_t kind, const char *ptr) {
+    int32_t pos = meta_skip_ws(ptr, 0);
+    if (ptr[pos] != '{') {
+        return -1;
+    }
+
+    pos ++;
+
+    int32_t count = 0;
+    while (true) {
+        if (kind == EcsStructType) {
+            pos = meta_parse_member(ptr, pos);
+        } else {
+            pos = meta_parse_constant(ptr, pos);
+        }
+
+        if (pos <= 0) {
+            break;
+        }
+
+        count ++;
+    }
+
+    return pos < 0 ? -1 : count;
+}
+
+// Parser self test, runs when the header is compiled
+static_assert(meta_count(EcsStructType, "{int32_t x; int32_t y;}") == 2, "");
+static_assert(meta_count(EcsStructType, "{float _x; char *_name;}") == 2, "");
+static_assert(meta_count(EcsStructType, "{_Bool b; int32_t arr[3];}") == 2, "");
+static_assert(meta_count(EcsStructType,
+    "{ecs_vector(int32_t) v; ECS_PRIVATE; int32_t p;}") == 1, "");
+static_assert(meta_count(EcsStructType, "{}") == 0, "");
+static_assert(meta_count(EcsStructType, "{int32_t x}") == -1, "");
+static_assert(meta_count(EcsStructType, "{int32_t 1x;}") == -1, "");
+static_assert(meta_count(EcsStructType, "{int32_t arr[];}") == -1, "");
+static_assert(meta_count(EcsEnumType, "{Red, Green, _Blue}") == 3, "");
+static_assert(meta_count(EcsEnumType, "{A = 1, B = 0x2, C = -3}") == 3, "");
+static_assert(meta_count(EcsEnumType, "{Red Green}") == -1, "");
+
+}
+}
+
+#endif
+
 ECS_STRUCT( EcsMetaType, {
     ecs_type_kind_t kind;
     ecs_size_t size;
@@ -207,25 +462,55 @@ ECS_STRUCT( EcsPrimitive, {
 
 // Define EcsBitmask for both C and C++. Both representations are equivalent in
 // memory, but allow for a nicer type-safe API in C++
+//
+// The private members are lookup tables that are derived from the constants
+// when the type is set. Values are decomposed into names by first matching the
+// constants with multiple bits, and then walking the remaining bits. Names are
+// translated to values with a hash map.
 #if defined(__cplusplus) && !defined(FLECS_NO_CPP)
 ECS_STRUCT( EcsBitmask, {
     flecs::map<int32_t, flecs::string> constants;
+
+ECS_PRIVATE
+    ecs_vector_t *bits;       /* Names of single bit constants, by bit index */
+    ecs_vector_t *compounds;  /* Constants with multiple bits, most bits first */
+    ecs_map_t *values;        /* Values keyed by hash of name */
 });
 #else
 ECS_STRUCT( EcsBitmask, {
     ecs_map(int32_t, ecs_string_t) constants;
+
+ECS_PRIVATE
+    ecs_vector_t *bits;       /* Names of single bit constants, by bit index */
+    ecs_vector_t *compounds;  /* Constants with multiple bits, most bits first */
+    ecs_map_t *values;        /* Values keyed by hash of name */
 });
 #endif
 
 // Define EcsEnum for both C and C++. Both representations are equivalent in
 // memory, but allow for a nicer type-safe API in C++
+//
+// The private members are lookup tables that are derived from the constants
+// when the type is set. Values are translated to names with the names table
+// when the constants are (nearly) contiguous, and with the constants map if
+// not. Names are translated to values with a hash map.
 #if defined(__cplusplus) && !defined(FLECS_NO_CPP)
 ECS_STRUCT( EcsEnum, {
     flecs::map<int32_t, flecs::string> constants;
+
+ECS_PRIVATE
+    int32_t min_value;        /* Value of the first element in names */
+    ecs_vector_t *names;      /* Names indexed by value - min_value */
+    ecs_map_t *values;        /* Values keyed by hash of name */
 });
 #else
 ECS_STRUCT( EcsEnum, {
     ecs_map(int32_t, ecs_string_t) constants;
+
+ECS_PRIVATE
+    int32_t min_value;        /* Value of the first element in names */
+    ecs_vector_t *names;      /* Names indexed by value - min_value */
+    ecs_map_t *values;        /* Values keyed by hash of name */
 });
 #endif
 
@@ -276,12 +561,21 @@ ECS_ENUM_C( ecs_type_op_kind_t, {
     EcsOpPop,
     EcsOpArray,
     EcsOpVector,
-    EcsOpMap
+    EcsOpMap,
+    EcsOpBlit
 });
 
 typedef ecs_vector_t ecs_type_op_vector_t;
 typedef ecs_vector_t ecs_constant_vector_t;
 
+/* Compiled reference to the type operations of an element or key type. The ops
+ * are resolved when the referencing type is serialized, and updated when the
+ * serializer of the element type is rebuilt. Reading them does not write. */
+typedef struct ecs_type_op_ref_t {
+    ecs_ref_t ref;
+    ecs_vector_t *ops;
+} ecs_type_op_ref_t;
+
 ECS_STRUCT_C( ecs_type_op_t, {
     ecs_entity_t type;
     ecs_type_op_kind_t kind;
@@ -297,17 +591,29 @@ ECS_PRIVATE
     union {
         ecs_primitive_kind_t primitive;
         ecs_ref_t constant;
-        ecs_ref_t collection;
+        ecs_type_op_ref_t collection;
 
         struct {
-            ecs_ref_t key;
-            ecs_ref_t element;
+            ecs_type_op_ref_t key;
+            ecs_type_op_ref_t element;
         } map;
     } is;
 });
 
 ECS_STRUCT_C( EcsMetaTypeSerializer, {
     ecs_vector(ecs_type_op_t) ops;
+    ecs_vector(ecs_type_op_t) opt_ops; /* Flattened ops without push/pop, with
+                                        * plain data coalesced in EcsOpBlit */
+    bool is_pod;         /* Value can be copied as bytes (may have padding) */
+    bool owns_heap;      /* Value contains strings, vectors or maps */
+    bool has_entities;   /* Value contains entity handles */
+    bool has_floats;     /* Value contains floating point numbers */
+    int32_t max_depth;   /* Max number of nested scopes in value */
+
+ECS_PRIVATE
+    ecs_map_t *members;  /* Op index of members keyed by scope and name */
+    ecs_vector_t *cmp_ops; /* Optimized ops with floats kept apart from blits,
+                            * NULL if the value has no floats */
 });
 
 #endif
@@ -321,6 +627,108 @@ extern "C" {
 //// Pretty printer
 ////////////////////////////////////////////////////////////////////////////////
 
+#define ECS_META_SINK_MAX_DEPTH (32)
+
+/** Callback that receives serialized output. The string is not 0-terminated.
+ * Return a non-zero value to stop serialization. */
+typedef int (*ecs_meta_write_action_t)(
+    void *ctx,
+    const char *str,
+    ecs_size_t len);
+
+/** Destination of serialized output. A sink writes to a caller provided
+ * buffer, forwards output to a write action, or both, in which case the buffer
+ * is flushed to the action when it is full. Initialize a sink with one of the
+ * ecs_meta_sink_* functions. */
+typedef struct ecs_meta_sink_t {
+    ecs_meta_write_action_t action;
+    void *ctx;
+    char *buf;
+    ecs_size_t size;
+    ecs_size_t count;      /* Number of characters in buffer */
+    ecs_size_t written;    /* Total number of characters produced */
+    bool overflow;         /* Output did not fit in buffer without action */
+    bool failed;           /* Action returned an error */
+
+    /* Separators of nested lists */
+    int32_t list_sp;
+    int32_t list_count[ECS_META_SINK_MAX_DEPTH];
+    const char *list_sep[ECS_META_SINK_MAX_DEPTH];
+
+    /* Names of entity values, set while serializing a world */
+    struct ecs_meta_name_cache_t *name_cache;
+} ecs_meta_sink_t;
+
+/** Create sink that writes to a fixed size buffer. Output that does not fit is
+ * truncated, and the overflow member is set. The buffer is 0-terminated after
+ * serialization, and the written member contains the length of the complete
+ * output, so the value can be serialized again into a larger buffer. */
+FLECS_META_EXPORT
+ecs_meta_sink_t ecs_meta_sink_buf(
+    char *buf,
+    ecs_size_t size);
+
+/** Create sink that forwards output to a write action. If buf is not NULL,
+ * output is collected in buf and forwarded when the buffer is full or the sink
+ * is flushed. */
+FLECS_META_EXPORT
+ecs_meta_sink_t ecs_meta_sink_action(
+    ecs_meta_write_action_t action,
+    void *ctx,
+    char *buf,
+    ecs_size_t size);
+
+/** Forward buffered output to the write action, or 0-terminate the buffer of a
+ * sink without action. Returns -1 if the action failed. */
+FLECS_META_EXPORT
+int ecs_meta_sink_flush(
+    ecs_meta_sink_t *sink);
+
+/** Write action for a FILE* context, for example stdout. */
+FLECS_META_EXPORT
+int ecs_meta_write_file(
+    void *ctx,
+    const char *str,
+    ecs_size_t len);
+
+/** Serialize value to sink. The sink is flushed after serialization. Returns
+ * -1 if the value could not be serialized or the action failed. */
+FLECS_META_EXPORT
+int ecs_ptr_to_sink(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    ecs_meta_sink_t *sink);
+
+/** Serialize entity to sink, in the same format as ecs_entity_to_str. */
+FLECS_META_EXPORT
+int ecs_entity_to_sink(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_meta_sink_t *sink);
+
+/** Serialize all entities in the world to sink. Tables are iterated, and the
+ * serializer of each column is resolved once per table. Entities are written
+ * in the same format as ecs_entity_to_str, separated by newlines. Tables with
+ * no components that have a serializer are skipped. Use a sink with a write
+ * action to dump large worlds with bounded memory. */
+FLECS_META_EXPORT
+int ecs_world_to_str_stream(
+    ecs_world_t *world,
+    ecs_meta_sink_t *sink);
+
+/** Convert value to a string in a caller provided buffer. Does not allocate
+ * memory. Returns the length of the complete string like snprintf, which is
+ * larger than or equal to len if the output was truncated, or -1 if the value
+ * could not be serialized. */
+FLECS_META_EXPORT
+ecs_size_t ecs_ptr_to_str_buf(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    char *buf,
+    ecs_size_t len);
+
 /** Convert value to a string. */
 FLECS_META_EXPORT
 char* ecs_ptr_to_str(
@@ -334,6 +742,211 @@ char* ecs_entity_to_str(
     ecs_world_t *world, 
     ecs_entity_t entity);
 
+/** Convert array of values to a string, for example a table column. The
+ * serializer is looked up once for all values. */
+FLECS_META_EXPORT
+char* ecs_array_to_str(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    int32_t count);
+
+/** Convert the entities of an iterator to a string. The components of each
+ * entity are serialized in the same format as ecs_entity_to_str. Serializers 
+ * and component columns are resolved once for all entities. */
+FLECS_META_EXPORT
+char* ecs_iter_to_str(
+    ecs_iter_t *it);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Binary serializer
+////////////////////////////////////////////////////////////////////////////////
+
+/** Encode value in binary format. Primitive values are encoded fixed-width
+ * little-endian, strings and vectors are prefixed with their length and maps
+ * with their element count. The encoded value is appended to out, which is a
+ * vector of bytes. */
+FLECS_META_EXPORT
+int ecs_meta_to_binary(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    ecs_vector_t **out);
+
+/** Decode binary value into existing value. Resources owned by the existing 
+ * value are reused or released. Returns the number of bytes read, or -1 if the
+ * data is invalid. Validation is limited to the framing of the data: reads
+ * stay within bounds, and lengths, element counts, nesting and map keys are
+ * checked. Values of primitives, such as bools and enums, are not. */
+FLECS_META_EXPORT
+int ecs_meta_from_binary(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const void *data,
+    ecs_size_t size);
+
+/** Same as ecs_meta_from_binary, but without validating the data. Only use
+ * this for data that was created by ecs_meta_to_binary. */
+FLECS_META_EXPORT
+int ecs_meta_from_binary_trusted(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const void *data);
+
+/** Return pointer to value in binary data without decoding it. This is only
+ * possible for plain types without padding on little-endian hosts, and if the
+ * data is properly aligned. Returns NULL otherwise. */
+FLECS_META_EXPORT
+const void* ecs_meta_binary_view(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *data,
+    ecs_size_t size);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Comparison
+////////////////////////////////////////////////////////////////////////////////
+
+/** Test if two values are equal. Strings, vectors, maps and floating point
+ * numbers are compared by value, other members bytewise. As with the == 
+ * operator, -0.0 equals 0.0. Unlike the == operator, floating point numbers
+ * with the same bits are equal, so NaN only equals a NaN with the same
+ * payload. Padding and private members are ignored. */
+FLECS_META_EXPORT
+bool ecs_meta_equals(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *a,
+    const void *b);
+
+/** Compare two arrays of values. Writes whether each pair of values is equal
+ * to result, and returns the number of equal pairs. */
+FLECS_META_EXPORT
+int32_t ecs_meta_equals_n(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *a,
+    const void *b,
+    int32_t count,
+    bool *result);
+
+/** Compute hash of value. Values that are equal have the same hash. */
+FLECS_META_EXPORT
+uint64_t ecs_meta_hash(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr);
+
+/** Compute hashes of an array of values. */
+FLECS_META_EXPORT
+void ecs_meta_hash_n(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    int32_t count,
+    uint64_t *result);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Delta encoding
+////////////////////////////////////////////////////////////////////////////////
+
+/** Encode the difference between two values. The delta contains a bitmask of
+ * changed members followed by the binary encoded values of changed members.
+ * Vector members are encoded per element. The delta is appended to out, which
+ * is a vector of bytes. */
+FLECS_META_EXPORT
+int ecs_meta_diff(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *old_value,
+    const void *new_value,
+    ecs_vector_t **out);
+
+/** Apply a delta created by ecs_meta_diff to a value that is equal to the old
+ * value passed to ecs_meta_diff. Returns the number of bytes read from the 
+ * delta, or -1 if the delta is invalid. */
+FLECS_META_EXPORT
+int ecs_meta_patch(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *value,
+    const void *delta,
+    ecs_size_t size);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Struct of arrays
+////////////////////////////////////////////////////////////////////////////////
+
+/** Get the member arrays for transposing a type. Each primitive, enum, bitmask
+ * or array member gets its own array, nested structs are flattened. If sizes
+ * is not NULL, it is populated with up to max_count element sizes. Returns the
+ * number of member arrays, or -1 if the type can't be transposed because it
+ * owns heap memory (strings, vectors or maps). */
+FLECS_META_EXPORT
+int32_t ecs_meta_soa_layout(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    ecs_size_t *sizes,
+    int32_t max_count);
+
+/** Scatter an array of count values into one array per member. The soa
+ * parameter must point to as many buffers as ecs_meta_soa_layout returns, each
+ * large enough to hold count member values. Values are copied bytewise, so
+ * types that own heap memory are rejected. Returns 0 if successful, or -1 if
+ * the type owns heap memory. */
+FLECS_META_EXPORT
+int ecs_meta_transpose_to_soa(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *aos,
+    int32_t count,
+    void **soa);
+
+/** Gather per-member arrays created by ecs_meta_transpose_to_soa back into an
+ * array of count values. Returns 0 if successful, or -1 if the type owns heap
+ * memory. */
+FLECS_META_EXPORT
+int ecs_meta_transpose_from_soa(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *aos,
+    int32_t count,
+    void * const *soa);
+
+
+////////////////////////////////////////////////////////////////////////////////
+//// Type registry snapshots
+////////////////////////////////////////////////////////////////////////////////
+
+/** Save all registered types to a snapshot. The snapshot contains the type
+ * definitions, members, constants and compiled serializers, and is appended
+ * to out, which is a vector of bytes. A snapshot can only be loaded by a build
+ * for the same platform. */
+FLECS_META_EXPORT
+int ecs_meta_save_registry(
+    ecs_world_t *world,
+    ecs_vector_t **out);
+
+/** Load types from a snapshot without parsing descriptors. Types that are
+ * already registered are skipped. Returns -1 without changing the world if the
+ * snapshot is invalid, was created by an incompatible build, or contains a
+ * type that is registered with a different definition. In that case types
+ * should be registered as usual.
+ *
+ * Registering a loaded type with ECS_META only parses the descriptor if the
+ * definition changed since the snapshot was created. */
+FLECS_META_EXPORT
+int ecs_meta_load_registry(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Serialization utilities
@@ -405,6 +1018,54 @@ ecs_size_t ecs_stresc(
 
 #define ECS_META_MAX_SCOPE_DEPTH (32) /* >32 levels of nesting is not sane */
 
+/** Bump allocator for transient values. Allocations are served from the
+ * buffer passed to ecs_meta_arena_init, and from heap blocks when the buffer is
+ * full. All allocations are released at once with ecs_meta_arena_reset.
+ *
+ * Values decoded into an arena do not own their strings. They must not be
+ * stored in component storage or passed to anything that releases a value,
+ * such as a component destructor or a cursor without an arena. Copying them
+ * into a component with ecs_set is allowed, as the copy owns its strings.
+ * After a reset the strings of decoded values dangle, so values must be zeroed
+ * before they are decoded into again. */
+typedef struct ecs_meta_arena_t {
+    char *buf;                           /* Current block */
+    ecs_size_t size;
+    ecs_size_t used;
+    char *initial_buf;                   /* Caller provided block */
+    ecs_size_t initial_size;
+    struct ecs_meta_arena_block_t *blocks; /* Heap blocks, newest first */
+} ecs_meta_arena_t;
+
+/* Initialize arena. The buffer may be NULL. */
+FLECS_META_EXPORT
+void ecs_meta_arena_init(
+    ecs_meta_arena_t *arena,
+    void *buf,
+    ecs_size_t size);
+
+/* Allocate memory with 8 byte alignment from arena */
+FLECS_META_EXPORT
+void* ecs_meta_arena_alloc(
+    ecs_meta_arena_t *arena,
+    ecs_size_t size);
+
+/* Returns whether memory was allocated from arena */
+FLECS_META_EXPORT
+bool ecs_meta_arena_owns(
+    const ecs_meta_arena_t *arena,
+    const void *ptr);
+
+/* Release all allocations. The largest heap block is kept for reuse. */
+FLECS_META_EXPORT
+void ecs_meta_arena_reset(
+    ecs_meta_arena_t *arena);
+
+/* Free heap blocks of arena */
+FLECS_META_EXPORT
+void ecs_meta_arena_fini(
+    ecs_meta_arena_t *arena);
+
 typedef struct ecs_meta_scope_t {
     ecs_entity_t type;
     ecs_vector_t *ops;
@@ -414,13 +1075,27 @@ typedef struct ecs_meta_scope_t {
     int32_t count;
     void *base;
     ecs_vector_t *vector;
+    ecs_map_t *members; /* Member index of ops, NULL if ops are not indexed */
+    ecs_map_t *map;     /* Map of map scope, alternates between key and value */
+    ecs_vector_t *key_ops;
+    ecs_map_key_t key;
+    bool is_key;
     bool is_collection;
 } ecs_meta_scope_t;
 
 typedef struct ecs_meta_cursor_t {
     ecs_world_t *world;
-    ecs_meta_scope_t scope[ECS_META_MAX_SCOPE_DEPTH];
     int32_t depth;
+    int32_t max_depth;  /* Number of scopes in scope array */
+
+    /* If set, strings are allocated from the arena. Previous values are not
+     * freed, and must be NULL or allocated from the same arena. See
+     * ecs_meta_arena_t for which values can be decoded into an arena. */
+    ecs_meta_arena_t *arena;
+
+    /* Must be the last member. Cursors created with ecs_meta_cursor_init only
+     * have space for the scopes the type can use. */
+    ecs_meta_scope_t scope[ECS_META_MAX_SCOPE_DEPTH];
 } ecs_meta_cursor_t;
 
 FLECS_META_EXPORT
@@ -429,10 +1104,37 @@ ecs_meta_cursor_t ecs_meta_cursor(
     ecs_entity_t type, 
     void *base);
 
+/* Size of a cursor for type, with as many scopes as the type can nest */
+FLECS_META_EXPORT
+ecs_size_t ecs_meta_cursor_size(
+    ecs_world_t *world,
+    ecs_entity_t type);
+
+/* Initialize cursor in memory of at least ecs_meta_cursor_size bytes, that is
+ * aligned for ecs_meta_cursor_t */
+FLECS_META_EXPORT
+ecs_meta_cursor_t* ecs_meta_cursor_init(
+    void *mem,
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *base);
+
+/* Move cursor to the start of a new value of the same type. Does not look up
+ * the type again. */
+FLECS_META_EXPORT
+void ecs_meta_cursor_reset(
+    ecs_meta_cursor_t *cursor,
+    void *base);
+
 FLECS_META_EXPORT
 void* ecs_meta_get_ptr(
     ecs_meta_cursor_t *cursor);
 
+/* Get type op of the current value */
+FLECS_META_EXPORT
+ecs_type_op_t* ecs_meta_get_op(
+    ecs_meta_cursor_t *cursor);
+
 FLECS_META_EXPORT
 int ecs_meta_next(
     ecs_meta_cursor_t *cursor);
@@ -451,6 +1153,13 @@ FLECS_META_EXPORT
 int ecs_meta_push(
     ecs_meta_cursor_t *cursor);
 
+/* Push scope of collection that will contain count elements. Vectors and maps
+ * are allocated with space for count elements. */
+FLECS_META_EXPORT
+int ecs_meta_push_n(
+    ecs_meta_cursor_t *cursor,
+    int32_t count);
+
 FLECS_META_EXPORT
 int ecs_meta_pop(
     ecs_meta_cursor_t *cursor);
@@ -480,11 +1189,42 @@ int ecs_meta_set_float(
     ecs_meta_cursor_t *cursor,
     double value);
 
+/* Set count elements of a collection of primitives, starting at the current
+ * element. The cursor is moved to the last element that is set. No elements
+ * are set if a value is out of range for the element type. */
+FLECS_META_EXPORT
+int ecs_meta_set_int_array(
+    ecs_meta_cursor_t *cursor,
+    const int64_t *values,
+    int32_t count);
+
+FLECS_META_EXPORT
+int ecs_meta_set_uint_array(
+    ecs_meta_cursor_t *cursor,
+    const uint64_t *values,
+    int32_t count);
+
+FLECS_META_EXPORT
+int ecs_meta_set_float_array(
+    ecs_meta_cursor_t *cursor,
+    const double *values,
+    int32_t count);
+
 FLECS_META_EXPORT
 int ecs_meta_set_string(
     ecs_meta_cursor_t *cursor,
     const char *value);
 
+FLECS_META_EXPORT
+int ecs_meta_set_enum_name(
+    ecs_meta_cursor_t *cursor,
+    const char *value);
+
+FLECS_META_EXPORT
+int ecs_meta_set_bitmask_names(
+    ecs_meta_cursor_t *cursor,
+    const char *value);
+
 FLECS_META_EXPORT
 int ecs_meta_set_entity(
     ecs_meta_cursor_t *cursor,
@@ -495,6 +1235,81 @@ int ecs_meta_set_null(
     ecs_meta_cursor_t *cursor);
 
 
+////////////////////////////////////////////////////////////////////////////////
+//// Value parser
+////////////////////////////////////////////////////////////////////////////////
+
+/* Parse value in the format of ecs_ptr_to_str. Returns a pointer to the first
+ * character after the value and trailing whitespace, or NULL if the expression
+ * is invalid. Errors are logged with their line and column. */
+FLECS_META_EXPORT
+const char* ecs_meta_from_str(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const char *expr);
+
+/* Same as ecs_meta_from_str, but parses into the current value of a cursor */
+FLECS_META_EXPORT
+const char* ecs_meta_cursor_from_str(
+    ecs_meta_cursor_t *cursor,
+    const char *expr);
+
+/* Invoked by a reader for each value. A non-zero return value stops reading. */
+typedef int (*ecs_meta_read_action_t)(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    void *ctx);
+
+/* Reader that parses a stream of values from chunks of input. Values are
+ * separated by a ',' or a newline, or end with the bracket that closes them.
+ * Values inside a chunk are parsed in place; only a value that continues in
+ * the next chunk is copied. */
+typedef struct ecs_meta_reader_t {
+    void *ptr;                      /* Value that is parsed into */
+    const char *name;               /* Name used in errors, type name if NULL */
+    ecs_meta_read_action_t action;
+    void *ctx;
+
+    /* Value that continues in the next chunk */
+    char *buf;
+    ecs_size_t size;
+    ecs_size_t count;
+    int64_t buf_offset;             /* Offset of buffered value in stream */
+
+    int64_t offset;                 /* Offset of next chunk in stream */
+    int32_t depth;                  /* Number of open brackets */
+    char quote;                     /* Delimiter of open string or character */
+    bool escape;                    /* Previous character was a backslash */
+    bool failed;
+
+    ecs_meta_cursor_t cursor;
+} ecs_meta_reader_t;
+
+FLECS_META_EXPORT
+ecs_meta_reader_t ecs_meta_reader(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    ecs_meta_read_action_t action,
+    void *ctx);
+
+/* Read chunk of input. Returns -1 if a value could not be parsed, or if the
+ * action stopped reading. */
+FLECS_META_EXPORT
+int ecs_meta_reader_feed(
+    ecs_meta_reader_t *reader,
+    const char *chunk,
+    ecs_size_t len);
+
+/* Parse the last value if the stream did not end with a separator, and free
+ * resources of the reader. */
+FLECS_META_EXPORT
+int ecs_meta_reader_fini(
+    ecs_meta_reader_t *reader);
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Module implementation
 ////////////////////////////////////////////////////////////////////////////////
@@ -515,6 +1330,9 @@ typedef struct FlecsMeta {
 extern "C" {
 #endif
 
+/** Import the module. The module does not use the world context, which remains
+ * available to the application. Worlds that import the module must not be
+ * created or deleted while another thread uses the module. */
 FLECS_META_EXPORT
 void FlecsMetaImport(
     ecs_world_t *world);
@@ -614,11 +1432,19 @@ flecs::entity meta(flecs::world& world) {
 //// Serialize values to string
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace _ {
+    inline int string_write(void *ctx, const char *str, ecs_size_t len) {
+        static_cast<std::string*>(ctx)->append(str, static_cast<size_t>(len));
+        return 0;
+    }
+}
+
 template <typename T>
 std::string pretty_print(flecs::world& world, flecs::entity_t type, T& data) {
-    char *str = ecs_ptr_to_str(world.c_ptr(), type, &data);
-    std::string result = std::string(str);
-    free(str);
+    std::string result;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(
+        _::string_write, &result, nullptr, 0);
+    ecs_ptr_to_sink(world.c_ptr(), type, &data, &sink);
     return result;
 }
 
@@ -635,9 +1461,10 @@ std::string pretty_print(flecs::world& world, T& data) {
 
 template <>
 inline std::string pretty_print<flecs::entity>(flecs::world& world, flecs::entity& entity) {
-    char *str = ecs_entity_to_str(world.c_ptr(), entity.id());
-    std::string result = std::string(str);
-    free(str);
+    std::string result;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(
+        _::string_write, &result, nullptr, 0);
+    ecs_entity_to_sink(world.c_ptr(), entity.id(), &sink);
     return result;
 }
 
@@ -0,0 +1,144 @@
+#include <flecs_meta.h>
+
+/* Minimum size of a heap block */
+#define ARENA_MIN_BLOCK_SIZE (4096)
+
+typedef struct ecs_meta_arena_block_t {
+    struct ecs_meta_arena_block_t *next;
+    ecs_size_t size;
+    /* Storage is stored after the block header */
+} ecs_meta_arena_block_t;
+
+/* Size of block header, rounded up so that storage is aligned */
+#define ARENA_BLOCK_HDR\
+    ((ECS_SIZEOF(ecs_meta_arena_block_t) + 7) & ~7)
+
+#define ARENA_BLOCK_STORAGE(block)\
+    ((char*)(block) + ARENA_BLOCK_HDR)
+
+void ecs_meta_arena_init(
+    ecs_meta_arena_t *arena,
+    void *buf,
+    ecs_size_t size)
+{
+    ecs_assert(arena != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!buf || size >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    arena->buf = buf;
+    arena->size = buf ? size : 0;
+    arena->used = 0;
+    arena->initial_buf = arena->buf;
+    arena->initial_size = arena->size;
+    arena->blocks = NULL;
+}
+
+void* ecs_meta_arena_alloc(
+    ecs_meta_arena_t *arena,
+    ecs_size_t size)
+{
+    ecs_assert(arena != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(size >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    /* Keep allocations 8 byte aligned. The caller provided buffer is assumed
+     * to be aligned, heap blocks are aligned by ecs_os_malloc. */
+    size = (size + 7) & ~7;
+
+    if ((arena->used + size) > arena->size) {
+        /* Blocks grow geometrically, so the number of heap allocations is
+         * logarithmic in the total size of a decode */
+        ecs_size_t block_size = arena->size * 2;
+        if (block_size < ARENA_MIN_BLOCK_SIZE) {
+            block_size = ARENA_MIN_BLOCK_SIZE;
+        }
+        if (block_size < size) {
+            block_size = size;
+        }
+
+        ecs_meta_arena_block_t *block = ecs_os_malloc(
+            ARENA_BLOCK_HDR + block_size);
+        block->next = arena->blocks;
+        block->size = block_size;
+        arena->blocks = block;
+
+        arena->buf = ARENA_BLOCK_STORAGE(block);
+        arena->size = block_size;
+        arena->used = 0;
+    }
+
+    void *result = &arena->buf[arena->used];
+    arena->used += size;
+    return result;
+}
+
+static
+bool in_range(
+    const void *ptr,
+    const char *buf,
+    ecs_size_t size)
+{
+    uintptr_t p = (uintptr_t)ptr, b = (uintptr_t)buf;
+    return buf && p >= b && p < (b + (uintptr_t)size);
+}
+
+bool ecs_meta_arena_owns(
+    const ecs_meta_arena_t *arena,
+    const void *ptr)
+{
+    ecs_assert(arena != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (in_range(ptr, arena->initial_buf, arena->initial_size)) {
+        return true;
+    }
+
+    ecs_meta_arena_block_t *block = arena->blocks;
+    while (block) {
+        if (in_range(ptr, ARENA_BLOCK_STORAGE(block), block->size)) {
+            return true;
+        }
+        block = block->next;
+    }
+
+    return false;
+}
+
+void ecs_meta_arena_reset(
+    ecs_meta_arena_t *arena)
+{
+    ecs_assert(arena != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_arena_block_t *block = arena->blocks;
+    if (!block) {
+        arena->used = 0;
+        return;
+    }
+
+    /* The newest block is the largest, and is always larger than the caller
+     * provided buffer. Keep it, so that decoding a value of the same size 
+     * again does not allocate. */
+    ecs_meta_arena_block_t *next = block->next;
+    while (next) {
+        ecs_meta_arena_block_t *tmp = next->next;
+        ecs_os_free(next);
+        next = tmp;
+    }
+
+    block->next = NULL;
+    arena->buf = ARENA_BLOCK_STORAGE(block);
+    arena->size = block->size;
+    arena->used = 0;
+}
+
+void ecs_meta_arena_fini(
+    ecs_meta_arena_t *arena)
+{
+    ecs_assert(arena != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_arena_block_t *block = arena->blocks;
+    while (block) {
+        ecs_meta_arena_block_t *next = block->next;
+        ecs_os_free(block);
+        block = next;
+    }
+
+    ecs_meta_arena_init(arena, arena->initial_buf, arena->initial_size);
+}
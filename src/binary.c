@@ -0,0 +1,648 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "lifecycle.h"
+#include "binary.h"
+
+/* -- Writing -- */
+
+void ecs_meta_bin_write_bytes(
+    ecs_vector_t **out,
+    const void *ptr,
+    ecs_size_t size)
+{
+    if (size) {
+        void *dst = ecs_vector_addn(out, uint8_t, size);
+        ecs_os_memcpy(dst, ptr, size);
+    }
+}
+
+/* Append primitive value of size bytes in little-endian byte order */
+static
+void write_scalar(
+    ecs_vector_t **out,
+    const void *ptr,
+    ecs_size_t size)
+{
+#ifdef ECS_META_BIN_LITTLE_ENDIAN
+    ecs_meta_bin_write_bytes(out, ptr, size);
+#else
+    uint8_t *dst = ecs_vector_addn(out, uint8_t, size);
+    const uint8_t *src = ptr;
+    ecs_size_t i;
+    for (i = 0; i < size; i ++) {
+        dst[i] = src[size - i - 1];
+    }
+#endif
+}
+
+void ecs_meta_bin_write_u32(
+    ecs_vector_t **out,
+    uint32_t value)
+{
+    write_scalar(out, &value, ECS_SIZEOF(uint32_t));
+}
+
+static
+void write_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    const void *base,
+    ecs_size_t size,
+    int32_t count,
+    ecs_vector_t **out)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t op_count = ecs_vector_count(ops);
+    int32_t i;
+
+    for (i = 0; i < count; i ++) {
+        ecs_meta_bin_write(world, op, op_count, ECS_OFFSET(base, i * size), out);
+    }
+}
+
+static
+void write_string(
+    const char *str,
+    ecs_vector_t **out)
+{
+    if (!str) {
+        ecs_meta_bin_write_u32(out, ECS_META_BIN_NULL_STR);
+    } else {
+        ecs_size_t len = ecs_os_strlen(str);
+        ecs_meta_bin_write_u32(out, (uint32_t)len);
+        ecs_meta_bin_write_bytes(out, str, len);
+    }
+}
+
+void ecs_meta_bin_write(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    const void *base,
+    ecs_vector_t **out)
+{
+    int32_t i;
+    for (i = 0; i < op_count; i ++) {
+        ecs_type_op_t *op = &ops[i];
+        const void *ptr = ECS_OFFSET(base, op->offset);
+
+        switch(op->kind) {
+        case EcsOpHeader:
+        case EcsOpPush:
+        case EcsOpPop:
+            break;
+
+        case EcsOpBlit:
+            ecs_meta_bin_write_bytes(out, ptr, op->size);
+            break;
+
+        case EcsOpPrimitive:
+            if (op->is.primitive == EcsString) {
+                write_string(*(char**)ptr, out);
+            } else {
+                write_scalar(out, ptr, op->size);
+            }
+            break;
+
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            write_scalar(out, ptr, op->size);
+            break;
+
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op->is.collection);
+            write_values(world, ECS_META_BIN_OPS(elem), ptr, op->size,
+                op->count, out);
+            break;
+        }
+
+        case EcsOpVector: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op->is.collection);
+            ecs_vector_t *vec = *(ecs_vector_t**)ptr;
+            int32_t count = ecs_vector_count(vec);
+
+            ecs_meta_bin_write_u32(out, (uint32_t)count);
+            write_values(world, ECS_META_BIN_OPS(elem),
+                ecs_vector_first_t(vec, op->size, op->alignment),
+                op->size, count, out);
+            break;
+        }
+
+        case EcsOpMap: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op->is.map.element);
+            ecs_vector_t *elem_ops = ECS_META_BIN_OPS(elem);
+            ecs_map_t *map = *(ecs_map_t**)ptr;
+
+            ecs_meta_bin_write_u32(out, (uint32_t)ecs_map_count(map));
+
+            ecs_map_iter_t it = ecs_map_iter(map);
+            ecs_map_key_t key;
+            void *elem_ptr;
+
+            while ((elem_ptr = _ecs_map_next(&it, 0, &key))) {
+                write_scalar(out, &key, ECS_SIZEOF(ecs_map_key_t));
+                ecs_meta_bin_write(world,
+                    ecs_vector_first(elem_ops, ecs_type_op_t),
+                    ecs_vector_count(elem_ops), elem_ptr, out);
+            }
+            break;
+        }
+        }
+    }
+}
+
+/* -- Reading -- */
+
+int ecs_meta_bin_read_bytes(
+    ecs_meta_bin_reader_t *reader,
+    void *ptr,
+    ecs_size_t size)
+{
+    if (!reader->trusted && (reader->end - reader->ptr) < size) {
+        return -1;
+    }
+
+    ecs_os_memcpy(ptr, reader->ptr, size);
+    reader->ptr += size;
+
+    return 0;
+}
+
+static
+int read_scalar(
+    ecs_meta_bin_reader_t *reader,
+    void *ptr,
+    ecs_size_t size)
+{
+#ifdef ECS_META_BIN_LITTLE_ENDIAN
+    return ecs_meta_bin_read_bytes(reader, ptr, size);
+#else
+    if (!reader->trusted && (reader->end - reader->ptr) < size) {
+        return -1;
+    }
+
+    uint8_t *dst = ptr;
+    ecs_size_t i;
+    for (i = 0; i < size; i ++) {
+        dst[i] = reader->ptr[size - i - 1];
+    }
+
+    reader->ptr += size;
+
+    return 0;
+#endif
+}
+
+int ecs_meta_bin_read_u32(
+    ecs_meta_bin_reader_t *reader,
+    uint32_t *value)
+{
+    return read_scalar(reader, value, ECS_SIZEOF(uint32_t));
+}
+
+static
+int read_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    void *base,
+    ecs_size_t size,
+    int32_t count,
+    ecs_meta_bin_reader_t *reader)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t op_count = ecs_vector_count(ops);
+    int32_t i;
+
+    for (i = 0; i < count; i ++) {
+        if (ecs_meta_bin_read(
+            world, op, op_count, ECS_OFFSET(base, i * size), reader))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int read_string(
+    char **str,
+    ecs_meta_bin_reader_t *reader)
+{
+    uint32_t len;
+    if (ecs_meta_bin_read_u32(reader, &len)) {
+        return -1;
+    }
+
+    ecs_os_free(*str);
+
+    if (len == ECS_META_BIN_NULL_STR) {
+        *str = NULL;
+        return 0;
+    }
+
+    if (!reader->trusted && (uint64_t)(reader->end - reader->ptr) < len) {
+        *str = NULL;
+        return -1;
+    }
+
+    *str = ecs_os_malloc((ecs_size_t)len + 1);
+    ecs_os_memcpy(*str, reader->ptr, len);
+    (*str)[len] = '\0';
+    reader->ptr += len;
+
+    return 0;
+}
+
+ecs_size_t ecs_meta_bin_min_size(
+    ecs_world_t *world,
+    ecs_vector_t *ops)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ops);
+    ecs_size_t result = 0;
+
+    for (i = 0; i < count; i ++) {
+        switch(op[i].kind) {
+        case EcsOpHeader:
+        case EcsOpPush:
+        case EcsOpPop:
+            break;
+        case EcsOpPrimitive:
+            if (op[i].is.primitive == EcsString) {
+                result += ECS_SIZEOF(uint32_t);
+            } else {
+                result += op[i].size;
+            }
+            break;
+        case EcsOpBlit:
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            result += op[i].size;
+            break;
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+            result += op[i].count *
+                ecs_meta_bin_min_size(world, ECS_META_BIN_OPS(elem));
+            break;
+        }
+        case EcsOpVector:
+        case EcsOpMap:
+            result += ECS_SIZEOF(uint32_t);
+            break;
+        }
+    }
+
+    /* Every encoded value takes up at least one byte */
+    return result ? result : 1;
+}
+
+/* Values of recursive types can nest collections without limit. Bound the
+ * nesting of untrusted input, so that it can't exhaust the stack. */
+static
+int push_collection(
+    ecs_meta_bin_reader_t *reader)
+{
+    if (!reader->trusted && reader->depth >= ECS_META_MAX_SCOPE_DEPTH) {
+        return -1;
+    }
+
+    reader->depth ++;
+    return 0;
+}
+
+/* The element count of a collection is bounded by the number of elements that
+ * fit in the remaining input, so that a corrupt count can't cause allocations
+ * that are much larger than the input */
+static
+int read_count(
+    ecs_meta_bin_reader_t *reader,
+    ecs_size_t min_size,
+    int32_t *count)
+{
+    uint32_t value;
+    if (ecs_meta_bin_read_u32(reader, &value)) {
+        return -1;
+    }
+
+    if (!reader->trusted) {
+        if (value > ECS_MAX_I32 || (uint64_t)value * (uint64_t)min_size >
+            (uint64_t)(reader->end - reader->ptr))
+        {
+            return -1;
+        }
+    }
+
+    *count = (int32_t)value;
+
+    return 0;
+}
+
+void ecs_meta_bin_resize_vector(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    ecs_vector_t **vector,
+    int32_t count)
+{
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.collection);
+    int32_t old_count = ecs_vector_count(*vector);
+
+    if (count < old_count && elem->owns_heap) {
+        void *first = ecs_vector_first_t(*vector, op->size, op->alignment);
+        ecs_meta_fini_values(world, elem->opt_ops,
+            ECS_OFFSET(first, count * op->size), op->size, old_count - count);
+    }
+
+    if (!count) {
+        ecs_vector_free(*vector);
+        *vector = NULL;
+        return;
+    }
+
+    ecs_vector_set_count_t(vector, op->size, op->alignment, count);
+
+    if (count > old_count) {
+        void *first = ecs_vector_first_t(*vector, op->size, op->alignment);
+        ecs_os_memset(ECS_OFFSET(first, old_count * op->size), 0,
+            (count - old_count) * op->size);
+    }
+}
+
+static
+int read_map(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    ecs_map_t **map,
+    ecs_meta_bin_reader_t *reader)
+{
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.map.element);
+    ecs_type_op_t *hdr = ecs_vector_first(elem->opt_ops, ecs_type_op_t);
+    ecs_vector_t *elem_ops = ECS_META_BIN_OPS(elem);
+
+    /* Each entry is encoded as a key followed by the element */
+    ecs_size_t min_size = ECS_SIZEOF(ecs_map_key_t) +
+        ecs_meta_bin_min_size(world, elem_ops);
+
+    int32_t i, count;
+    if (read_count(reader, min_size, &count)) {
+        return -1;
+    }
+
+    /* Release the current contents, map elements are not reused */
+    if (*map) {
+        if (elem->owns_heap) {
+            ecs_map_iter_t it = ecs_map_iter(*map);
+            ecs_map_key_t key;
+            void *elem_ptr;
+
+            while ((elem_ptr = _ecs_map_next(&it, 0, &key))) {
+                ecs_meta_fini_values(world, elem->opt_ops, elem_ptr, 0, 1);
+            }
+        }
+
+        ecs_map_free(*map);
+        *map = NULL;
+    }
+
+    if (!count) {
+        return 0;
+    }
+
+    *map = _ecs_map_new(hdr->size, hdr->alignment, count);
+
+    /* Decode into a zero-initialized value, then transfer it to the map */
+    void *tmp = ecs_os_calloc(hdr->size);
+
+    for (i = 0; i < count; i ++) {
+        ecs_map_key_t key;
+        if (read_scalar(reader, &key, ECS_SIZEOF(ecs_map_key_t))) {
+            goto error;
+        }
+
+        if (!reader->trusted && _ecs_map_get(*map, hdr->size, key)) {
+            goto error;
+        }
+
+        if (ecs_meta_bin_read(world,
+            ecs_vector_first(elem_ops, ecs_type_op_t),
+            ecs_vector_count(elem_ops), tmp, reader))
+        {
+            ecs_meta_fini_values(world, elem->opt_ops, tmp, 0, 1);
+            goto error;
+        }
+
+        _ecs_map_set(*map, hdr->size, key, tmp);
+        ecs_os_memset(tmp, 0, hdr->size);
+    }
+
+    ecs_os_free(tmp);
+
+    return 0;
+error:
+    ecs_os_free(tmp);
+    return -1;
+}
+
+int ecs_meta_bin_read(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    void *base,
+    ecs_meta_bin_reader_t *reader)
+{
+    int32_t i;
+    for (i = 0; i < op_count; i ++) {
+        ecs_type_op_t *op = &ops[i];
+        void *ptr = ECS_OFFSET(base, op->offset);
+
+        switch(op->kind) {
+        case EcsOpHeader:
+        case EcsOpPush:
+        case EcsOpPop:
+            break;
+
+        case EcsOpBlit:
+            if (ecs_meta_bin_read_bytes(reader, ptr, op->size)) {
+                return -1;
+            }
+            break;
+
+        case EcsOpPrimitive:
+            if (op->is.primitive == EcsString) {
+                if (read_string(ptr, reader)) {
+                    return -1;
+                }
+            } else {
+                if (read_scalar(reader, ptr, op->size)) {
+                    return -1;
+                }
+            }
+            break;
+
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            if (read_scalar(reader, ptr, op->size)) {
+                return -1;
+            }
+            break;
+
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op->is.collection);
+            if (read_values(world, ECS_META_BIN_OPS(elem), ptr, op->size,
+                op->count, reader))
+            {
+                return -1;
+            }
+            break;
+        }
+
+        case EcsOpVector: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op->is.collection);
+            ecs_vector_t **vec = ptr;
+            int32_t count;
+
+            if (push_collection(reader)) {
+                return -1;
+            }
+
+            if (read_count(reader,
+                ecs_meta_bin_min_size(world, ECS_META_BIN_OPS(elem)), &count))
+            {
+                return -1;
+            }
+
+            ecs_meta_bin_resize_vector(world, op, vec, count);
+
+            if (read_values(world, ECS_META_BIN_OPS(elem),
+                ecs_vector_first_t(*vec, op->size, op->alignment),
+                op->size, count, reader))
+            {
+                return -1;
+            }
+
+            reader->depth --;
+            break;
+        }
+
+        case EcsOpMap:
+            if (push_collection(reader)) {
+                return -1;
+            }
+
+            if (read_map(world, op, ptr, reader)) {
+                return -1;
+            }
+
+            reader->depth --;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/* -- Public API -- */
+
+static
+int from_binary(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const void *data,
+    ecs_size_t size,
+    bool trusted)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_vector_t *ops = ECS_META_BIN_OPS(ser);
+
+    ecs_meta_bin_reader_t reader = {
+        .ptr = data,
+        .end = ECS_OFFSET(data, size),
+        .trusted = trusted
+    };
+
+    if (ecs_meta_bin_read(world, ecs_vector_first(ops, ecs_type_op_t),
+        ecs_vector_count(ops), ptr, &reader))
+    {
+        return -1;
+    }
+
+    return (int)(reader.ptr - (const uint8_t*)data);
+}
+
+int ecs_meta_to_binary(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    ecs_vector_t **out)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_vector_t *ops = ECS_META_BIN_OPS(ser);
+
+    ecs_meta_bin_write(world, ecs_vector_first(ops, ecs_type_op_t),
+        ecs_vector_count(ops), ptr, out);
+
+    return 0;
+}
+
+int ecs_meta_from_binary(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const void *data,
+    ecs_size_t size)
+{
+    return from_binary(world, type, ptr, data, size, false);
+}
+
+int ecs_meta_from_binary_trusted(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const void *data)
+{
+    return from_binary(world, type, ptr, data, 0, true);
+}
+
+const void* ecs_meta_binary_view(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *data,
+    ecs_size_t size)
+{
+#ifdef ECS_META_BIN_LITTLE_ENDIAN
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+
+    /* The encoding of a type that is a single blit without padding is the
+     * same as its in-memory representation */
+    if (!ecs_meta_is_contiguous(ser)) {
+        return NULL;
+    }
+
+    ecs_type_op_t *hdr = ecs_vector_first(ser->opt_ops, ecs_type_op_t);
+
+    if (size < hdr->size) {
+        return NULL;
+    }
+
+    if ((uintptr_t)data % (uintptr_t)hdr->alignment) {
+        return NULL;
+    }
+
+    return data;
+#else
+    (void)world;
+    (void)type;
+    (void)data;
+    (void)size;
+    return NULL;
+#endif
+}
@@ -0,0 +1,79 @@
+#ifndef FLECS_META_BINARY_H
+#define FLECS_META_BINARY_H
+
+#include "flecs_meta.h"
+
+/* Values are encoded as fixed-width little-endian for primitives, length
+ * prefixed strings and vectors, and count prefixed maps. On little-endian
+ * hosts plain data is encoded with the blits of the optimized ops, on
+ * big-endian hosts each primitive is byte swapped. */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define ECS_META_BIN_OPS(ser) ((ser)->ops)
+#else
+#define ECS_META_BIN_OPS(ser) ((ser)->opt_ops)
+#define ECS_META_BIN_LITTLE_ENDIAN
+#endif
+
+/* Length of a NULL string */
+#define ECS_META_BIN_NULL_STR (0xFFFFFFFFu)
+
+typedef struct ecs_meta_bin_reader_t {
+    const uint8_t *ptr;
+    const uint8_t *end;
+    bool trusted;       /* Skip bounds and length checks */
+    int32_t depth;      /* Number of collections being decoded */
+} ecs_meta_bin_reader_t;
+
+/* Append raw bytes */
+void ecs_meta_bin_write_bytes(
+    ecs_vector_t **out,
+    const void *ptr,
+    ecs_size_t size);
+
+/* Append unsigned 32 bit integer */
+void ecs_meta_bin_write_u32(
+    ecs_vector_t **out,
+    uint32_t value);
+
+/* Append encoding of value described by range of type ops */
+void ecs_meta_bin_write(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    const void *base,
+    ecs_vector_t **out);
+
+/* Read raw bytes */
+int ecs_meta_bin_read_bytes(
+    ecs_meta_bin_reader_t *reader,
+    void *ptr,
+    ecs_size_t size);
+
+/* Read unsigned 32 bit integer */
+int ecs_meta_bin_read_u32(
+    ecs_meta_bin_reader_t *reader,
+    uint32_t *value);
+
+/* Decode value described by range of type ops into existing value. Resources
+ * owned by the existing value are reused or released. */
+int ecs_meta_bin_read(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    void *base,
+    ecs_meta_bin_reader_t *reader);
+
+/* Minimum number of bytes of the encoding of a value described by type ops */
+ecs_size_t ecs_meta_bin_min_size(
+    ecs_world_t *world,
+    ecs_vector_t *ops);
+
+/* Resize vector of a vector op. Removed elements are released, added elements
+ * are zero-initialized. A vector resized to zero elements is freed. */
+void ecs_meta_bin_resize_vector(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    ecs_vector_t **vector,
+    int32_t count);
+
+#endif
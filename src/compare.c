@@ -0,0 +1,509 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+
+#define HASH_SEED (0x9E3779B97F4A7C15ull)
+#define HASH_PRIME (0xC2B2AE3D27D4EB4Full)
+
+/* Floating point members must be compared by value, which the blits of the
+ * optimized ops can't do. Types with floats use ops in which the floats are
+ * kept apart from the blits. */
+ecs_vector_t* ecs_meta_compare_ops(
+    const EcsMetaTypeSerializer *ser)
+{
+    if (ser->has_floats) {
+        ecs_assert(ser->cmp_ops != NULL, ECS_INTERNAL_ERROR, NULL);
+        return ser->cmp_ops;
+    }
+
+    return ser->opt_ops;
+}
+
+static
+bool is_float(
+    ecs_type_op_t *op)
+{
+    return op->kind == EcsOpPrimitive && 
+        (op->is.primitive == EcsF32 || op->is.primitive == EcsF64);
+}
+
+/* -- Equality -- */
+
+/* Floats with the same bits are equal, so that a value always equals itself.
+ * This allows for testing values bytewise before testing them by value. */
+static
+bool float_equals(
+    ecs_type_op_t *op,
+    const void *a,
+    const void *b)
+{
+    if (!memcmp(a, b, (size_t)(op->size * op->count))) {
+        return true;
+    }
+
+    int32_t i;
+    for (i = 0; i < op->count; i ++) {
+        if (op->is.primitive == EcsF32) {
+            if (((float*)a)[i] != ((float*)b)[i]) {
+                return false;
+            }
+        } else {
+            if (((double*)a)[i] != ((double*)b)[i]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static
+bool str_equals(
+    const char *a,
+    const char *b)
+{
+    if (a == b) {
+        return true;
+    }
+
+    if (!a || !b) {
+        return false;
+    }
+
+    return !strcmp(a, b);
+}
+
+static
+bool values_equal(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    int32_t op_count,
+    const void *a,
+    const void *b,
+    ecs_size_t size,
+    int32_t count);
+
+static
+bool map_equals(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    const ecs_map_t *a,
+    const ecs_map_t *b)
+{
+    if (ecs_map_count(a) != ecs_map_count(b)) {
+        return false;
+    }
+
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.map.element);
+    ecs_type_op_t *hdr = ecs_vector_first(elem->opt_ops, ecs_type_op_t);
+    ecs_vector_t *elem_ops = ecs_meta_compare_ops(elem);
+
+    ecs_map_iter_t it = ecs_map_iter(a);
+    ecs_map_key_t key;
+    void *a_elem;
+
+    /* Maps are equal when they contain the same keys with equal values,
+     * regardless of the order in which keys are stored */
+    while ((a_elem = _ecs_map_next(&it, 0, &key))) {
+        const void *b_elem = _ecs_map_get(b, hdr->size, key);
+        if (!b_elem) {
+            return false;
+        }
+
+        if (!values_equal(world, 
+            ecs_vector_first(elem_ops, ecs_type_op_t),
+            ecs_vector_count(elem_ops), a_elem, b_elem, 0, 1)) 
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+bool values_equal(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    int32_t op_count,
+    const void *a,
+    const void *b,
+    ecs_size_t size,
+    int32_t count)
+{
+    int32_t i, j;
+
+    for (i = 0; i < op_count; i ++) {
+        const void *a_ptr = ECS_OFFSET(a, op[i].offset);
+        const void *b_ptr = ECS_OFFSET(b, op[i].offset);
+
+        switch(op[i].kind) {
+        case EcsOpBlit:
+        case EcsOpPrimitive:
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            if (op[i].kind == EcsOpPrimitive &&
+                op[i].is.primitive == EcsString)
+            {
+                for (j = 0; j < count; j ++) {
+                    if (!str_equals(
+                        *(char**)ECS_OFFSET(a_ptr, j * size),
+                        *(char**)ECS_OFFSET(b_ptr, j * size)))
+                    {
+                        return false;
+                    }
+                }
+            } else if (is_float(&op[i])) {
+                for (j = 0; j < count; j ++) {
+                    if (!float_equals(&op[i], ECS_OFFSET(a_ptr, j * size),
+                        ECS_OFFSET(b_ptr, j * size)))
+                    {
+                        return false;
+                    }
+                }
+            } else {
+                for (j = 0; j < count; j ++) {
+                    if (memcmp(ECS_OFFSET(a_ptr, j * size),
+                        ECS_OFFSET(b_ptr, j * size),
+                        (size_t)(op[i].size * op[i].count)))
+                    {
+                        return false;
+                    }
+                }
+            }
+            break;
+
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+            ecs_vector_t *elem_ops = ecs_meta_compare_ops(elem);
+
+            for (j = 0; j < count; j ++) {
+                if (!values_equal(world, 
+                    ecs_vector_first(elem_ops, ecs_type_op_t),
+                    ecs_vector_count(elem_ops),
+                    ECS_OFFSET(a_ptr, j * size), ECS_OFFSET(b_ptr, j * size),
+                    op[i].size, op[i].count))
+                {
+                    return false;
+                }
+            }
+            break;
+        }
+
+        case EcsOpVector: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+            ecs_vector_t *elem_ops = ecs_meta_compare_ops(elem);
+
+            for (j = 0; j < count; j ++) {
+                ecs_vector_t *a_vec = *(ecs_vector_t**)ECS_OFFSET(a_ptr, j * size);
+                ecs_vector_t *b_vec = *(ecs_vector_t**)ECS_OFFSET(b_ptr, j * size);
+                int32_t elem_count = ecs_vector_count(a_vec);
+
+                if (elem_count != ecs_vector_count(b_vec)) {
+                    return false;
+                }
+
+                if (!values_equal(world, 
+                    ecs_vector_first(elem_ops, ecs_type_op_t),
+                    ecs_vector_count(elem_ops),
+                    ecs_vector_first_t(a_vec, op[i].size, op[i].alignment),
+                    ecs_vector_first_t(b_vec, op[i].size, op[i].alignment),
+                    op[i].size, elem_count))
+                {
+                    return false;
+                }
+            }
+            break;
+        }
+
+        case EcsOpMap:
+            for (j = 0; j < count; j ++) {
+                if (!map_equals(world, &op[i],
+                    *(ecs_map_t**)ECS_OFFSET(a_ptr, j * size),
+                    *(ecs_map_t**)ECS_OFFSET(b_ptr, j * size)))
+                {
+                    return false;
+                }
+            }
+            break;
+
+        case EcsOpHeader:
+        case EcsOpPush:
+        case EcsOpPop:
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool ecs_meta_ops_equal(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    const void *a,
+    const void *b)
+{
+    return values_equal(world, ops, op_count, a, b, 0, 1);
+}
+
+/* -- Hashing -- */
+
+static
+uint64_t hash_mix(
+    uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Hash bytes 8 at a time. Loads use memcpy so that unaligned ranges are
+ * supported, which compilers lower to a single load. */
+static
+uint64_t hash_bytes(
+    uint64_t h,
+    const void *ptr,
+    ecs_size_t size)
+{
+    const uint8_t *bytes = ptr;
+    uint64_t v;
+
+    while (size >= 8) {
+        memcpy(&v, bytes, 8);
+        h = (h ^ v) * HASH_PRIME;
+        h = (h << 31) | (h >> 33);
+        bytes += 8;
+        size -= 8;
+    }
+
+    v = (uint64_t)size << 56;
+    if (size) {
+        uint64_t tail = 0;
+        memcpy(&tail, bytes, (size_t)size);
+        v ^= tail;
+    }
+
+    return (h ^ v) * HASH_PRIME;
+}
+
+/* Hash floats so that values that compare equal have the same hash */
+static
+uint64_t hash_float(
+    ecs_type_op_t *op,
+    uint64_t h,
+    const void *ptr)
+{
+    int32_t i;
+    for (i = 0; i < op->count; i ++) {
+        double v;
+        if (op->is.primitive == EcsF32) {
+            v = (double)((float*)ptr)[i];
+        } else {
+            v = ((double*)ptr)[i];
+        }
+
+        if (v == 0) {
+            v = 0; /* -0.0 */
+        } else if (v != v) {
+            v = 0; /* NaN is not equal to anything, any hash will do */
+        }
+
+        h = hash_bytes(h, &v, ECS_SIZEOF(v));
+    }
+
+    return h;
+}
+
+static
+uint64_t hash_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    uint64_t h,
+    const void *base,
+    ecs_size_t size,
+    int32_t count);
+
+static
+uint64_t hash_map(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    uint64_t h,
+    const ecs_map_t *map)
+{
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.map.element);
+
+    ecs_map_iter_t it = ecs_map_iter(map);
+    ecs_map_key_t key;
+    void *elem_ptr;
+    uint64_t sum = 0;
+
+    /* Combine elements with a commutative operation, since the iteration
+     * order of a map does not depend on its contents alone */
+    while ((elem_ptr = _ecs_map_next(&it, 0, &key))) {
+        uint64_t elem_h = hash_bytes(HASH_SEED, &key, ECS_SIZEOF(key));
+        elem_h = hash_values(
+            world, ecs_meta_compare_ops(elem), elem_h, elem_ptr, 0, 1);
+        sum += hash_mix(elem_h);
+    }
+
+    h = hash_bytes(h, &sum, ECS_SIZEOF(sum));
+
+    int32_t count = ecs_map_count(map);
+    return hash_bytes(h, &count, ECS_SIZEOF(count));
+}
+
+static
+uint64_t hash_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    uint64_t h,
+    const void *base,
+    ecs_size_t size,
+    int32_t count)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, op_count = ecs_vector_count(ops);
+    int32_t j;
+
+    for (j = 0; j < count; j ++) {
+        const void *value = ECS_OFFSET(base, j * size);
+
+        for (i = 1; i < op_count; i ++) {
+            const void *ptr = ECS_OFFSET(value, op[i].offset);
+
+            switch(op[i].kind) {
+            case EcsOpBlit:
+            case EcsOpPrimitive:
+            case EcsOpEnum:
+            case EcsOpBitmask:
+                if (op[i].kind == EcsOpPrimitive &&
+                    op[i].is.primitive == EcsString)
+                {
+                    const char *str = *(char**)ptr;
+                    if (str) {
+                        h = hash_bytes(h, str, ecs_os_strlen(str));
+                    } else {
+                        h = hash_bytes(h, NULL, 0);
+                    }
+                } else if (is_float(&op[i])) {
+                    h = hash_float(&op[i], h, ptr);
+                } else {
+                    h = hash_bytes(h, ptr, op[i].size * op[i].count);
+                }
+                break;
+
+            case EcsOpArray: {
+                const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                    world, &op[i].is.collection);
+                h = hash_values(world, ecs_meta_compare_ops(elem), h, ptr,
+                    op[i].size, op[i].count);
+                break;
+            }
+
+            case EcsOpVector: {
+                const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                    world, &op[i].is.collection);
+                ecs_vector_t *vec = *(ecs_vector_t**)ptr;
+                int32_t elem_count = ecs_vector_count(vec);
+
+                h = hash_bytes(h, &elem_count, ECS_SIZEOF(elem_count));
+                h = hash_values(world, ecs_meta_compare_ops(elem), h,
+                    ecs_vector_first_t(vec, op[i].size, op[i].alignment),
+                    op[i].size, elem_count);
+                break;
+            }
+
+            case EcsOpMap:
+                h = hash_map(world, &op[i], h, *(ecs_map_t**)ptr);
+                break;
+
+            case EcsOpHeader:
+            case EcsOpPush:
+            case EcsOpPop:
+                break;
+            }
+        }
+    }
+
+    return h;
+}
+
+bool ecs_meta_equals(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *a,
+    const void *b)
+{
+    bool result;
+    ecs_meta_equals_n(world, type, a, b, 1, &result);
+    return result;
+}
+
+int32_t ecs_meta_equals_n(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *a,
+    const void *b,
+    int32_t count,
+    bool *result)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_vector_t *ops = ecs_meta_compare_ops(ser);
+    ecs_type_op_t *hdr = ecs_vector_first(ops, ecs_type_op_t);
+    ecs_size_t size = hdr->size;
+    int32_t i, equal_count = 0;
+
+    /* Unchanged columns are the common case, test them with one compare.
+     * This also applies to floats, which are equal if their bits are. */
+    if (ecs_meta_is_contiguous(ser) && !memcmp(a, b, (size_t)(size * count))) 
+    {
+        for (i = 0; i < count; i ++) {
+            result[i] = true;
+        }
+        return count;
+    }
+
+    for (i = 0; i < count; i ++) {
+        result[i] = values_equal(world, hdr, ecs_vector_count(ops),
+            ECS_OFFSET(a, i * size), ECS_OFFSET(b, i * size), size, 1);
+        equal_count += result[i];
+    }
+
+    return equal_count;
+}
+
+uint64_t ecs_meta_hash(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr)
+{
+    uint64_t result;
+    ecs_meta_hash_n(world, type, ptr, 1, &result);
+    return result;
+}
+
+void ecs_meta_hash_n(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    int32_t count,
+    uint64_t *result)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_vector_t *ops = ecs_meta_compare_ops(ser);
+    ecs_type_op_t *hdr = ecs_vector_first(ops, ecs_type_op_t);
+    ecs_size_t size = hdr->size;
+    int32_t i;
+
+    for (i = 0; i < count; i ++) {
+        result[i] = hash_mix(hash_values(world, ops, HASH_SEED,
+            ECS_OFFSET(ptr, i * size), size, 1));
+    }
+}
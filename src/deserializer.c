@@ -1,4 +1,8 @@
 #include "flecs_meta.h"
+#include "serializer.h"
+#include "lifecycle.h"
+#include "type.h"
+#include "world.h"
 
 static
 ecs_meta_scope_t* get_scope(
@@ -12,7 +16,8 @@ static
 ecs_type_op_t* get_op(
     ecs_meta_scope_t *scope)
 {
-    ecs_type_op_t *ops = ecs_vector_first(scope->ops, ecs_type_op_t);
+    ecs_vector_t *vec = scope->is_key ? scope->key_ops : scope->ops;
+    ecs_type_op_t *ops = ecs_vector_first(vec, ecs_type_op_t);
     ecs_assert(ops != NULL, ECS_INVALID_PARAMETER, NULL);
     return &ops[scope->cur_op];
 }
@@ -23,7 +28,12 @@ ecs_type_op_t* get_ptr(
 {
     ecs_type_op_t *op = get_op(scope);
 
-    if (scope->vector) {
+    /* Keys are written to the scope, and inserted when moving to the value */
+    if (scope->is_key) {
+        return (void*)&scope->key;
+    }
+
+    if (scope->vector && ecs_vector_count(scope->vector) <= scope->cur_elem) {
         _ecs_vector_set_min_count(&scope->vector, ECS_VECTOR_U(op->size, op->alignment), scope->cur_elem + 1);
         scope->base = ecs_vector_first_t(scope->vector, op->size, op->alignment);
     }
@@ -31,6 +41,30 @@ ecs_type_op_t* get_ptr(
     return ECS_OFFSET(scope->base, op->offset + op->size * scope->cur_elem);
 }
 
+static
+void cursor_init(
+    ecs_meta_cursor_t *cursor,
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const EcsMetaTypeSerializer *ser,
+    void *base,
+    int32_t max_depth)
+{
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+    ecs_assert(ops != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(ops[0].kind == EcsOpHeader, ECS_INVALID_PARAMETER, NULL);
+
+    cursor->world = world;
+    cursor->max_depth = max_depth;
+    cursor->arena = NULL;
+    cursor->scope[0].type = type;
+    cursor->scope[0].ops = ser->ops;
+    cursor->scope[0].members = ser->members;
+    cursor->scope[0].key_ops = NULL;
+
+    ecs_meta_cursor_reset(cursor, base);
+}
+
 ecs_meta_cursor_t ecs_meta_cursor(
     ecs_world_t *world,
     ecs_entity_t type, 
@@ -41,30 +75,76 @@ ecs_meta_cursor_t ecs_meta_cursor(
     ecs_assert(base != NULL, ECS_INVALID_PARAMETER, NULL);
     
     ecs_meta_cursor_t result;
-    ecs_entity_t ecs_entity(EcsMetaTypeSerializer) = 
-        ecs_lookup_fullpath(world, "flecs.meta.MetaTypeSerializer");
-    ecs_assert(ecs_entity(EcsMetaTypeSerializer) != 0, ECS_INVALID_PARAMETER, NULL);
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
+    ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    cursor_init(&result, world, type, ser, base, ECS_META_MAX_SCOPE_DEPTH);
+
+    return result;
+}
 
-    const EcsMetaTypeSerializer *ser = ecs_get(world, type, EcsMetaTypeSerializer);
+/* Number of scopes a cursor for a type needs, one for the value itself and
+ * one for each nested scope */
+static
+int32_t cursor_depth(
+    const EcsMetaTypeSerializer *ser)
+{
+    int32_t depth = ser->max_depth + 1;
+    ecs_assert(depth <= ECS_META_MAX_SCOPE_DEPTH, ECS_INVALID_PARAMETER, NULL);
+    return depth;
+}
+
+ecs_size_t ecs_meta_cursor_size(
+    ecs_world_t *world,
+    ecs_entity_t type)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
     ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
-    ecs_assert(ops != NULL, ECS_INVALID_PARAMETER, NULL);
-    ecs_assert(ops[0].kind == EcsOpHeader, ECS_INVALID_PARAMETER, NULL);
+    return (ecs_size_t)offsetof(ecs_meta_cursor_t, scope) + 
+        ECS_SIZEOF(ecs_meta_scope_t) * cursor_depth(ser);
+}
 
-    result.world = world;
-    result.depth = 0;
-    result.scope[0].type = type;
-    result.scope[0].ops = ser->ops;
-    result.scope[0].start = 1;
-    result.scope[0].cur_op = 1;
-    result.scope[0].cur_elem = 0;
-    result.scope[0].base = base;
-    result.scope[0].is_collection = false;
-    result.scope[0].count = 0;
-    result.scope[0].vector = NULL;
+ecs_meta_cursor_t* ecs_meta_cursor_init(
+    void *mem,
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *base)
+{
+    ecs_assert(mem != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(type != 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(base != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    return result;
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
+    ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_cursor_t *cursor = mem;
+    cursor_init(cursor, world, type, ser, base, cursor_depth(ser));
+
+    return cursor;
+}
+
+void ecs_meta_cursor_reset(
+    ecs_meta_cursor_t *cursor,
+    void *base)
+{
+    ecs_assert(cursor != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(base != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_scope_t *scope = &cursor->scope[0];
+    scope->start = 1;
+    scope->cur_op = 1;
+    scope->cur_elem = 0;
+    scope->count = 0;
+    scope->base = base;
+    scope->vector = NULL;
+    scope->map = NULL;
+    scope->key = 0;
+    scope->is_key = false;
+    scope->is_collection = false;
+
+    cursor->depth = 0;
 }
 
 void* ecs_meta_get_ptr(
@@ -73,10 +153,110 @@ void* ecs_meta_get_ptr(
     return get_ptr(cursor->scope);
 }
 
+ecs_type_op_t* ecs_meta_get_op(
+    ecs_meta_cursor_t *cursor)
+{
+    return get_op(get_scope(cursor));
+}
+
+/* Elements are inserted zero-initialized, so that their members can be set in
+ * place. Larger elements use a temporary zero buffer. */
+static const uint64_t zero_element[32];
+
+/* Keys are written to the scope with the type of the key. Convert them to a
+ * map key the way C converts the key type to ecs_map_key_t, so that signed
+ * keys are sign extended and the result does not depend on endianness. */
+static
+ecs_map_key_t map_key(
+    ecs_meta_scope_t *scope)
+{
+    ecs_type_op_t *op = ecs_vector_get(scope->key_ops, ecs_type_op_t, 1);
+    const void *ptr = &scope->key;
+
+    switch(op->kind) {
+    case EcsOpEnum:
+        return (ecs_map_key_t)*(const int32_t*)ptr;
+    case EcsOpBitmask:
+        return *(const uint32_t*)ptr;
+    case EcsOpPrimitive:
+        switch(op->is.primitive) {
+        case EcsBool:
+            return *(const bool*)ptr;
+        case EcsChar:
+            return (ecs_map_key_t)*(const char*)ptr;
+        case EcsByte:
+        case EcsU8:
+            return *(const uint8_t*)ptr;
+        case EcsU16:
+            return *(const uint16_t*)ptr;
+        case EcsU32:
+            return *(const uint32_t*)ptr;
+        case EcsI8:
+            return (ecs_map_key_t)*(const int8_t*)ptr;
+        case EcsI16:
+            return (ecs_map_key_t)*(const int16_t*)ptr;
+        case EcsI32:
+            return (ecs_map_key_t)*(const int32_t*)ptr;
+        case EcsI64:
+            return (ecs_map_key_t)*(const int64_t*)ptr;
+        case EcsUPtr:
+            return *(const uintptr_t*)ptr;
+        case EcsIPtr:
+            return (ecs_map_key_t)*(const intptr_t*)ptr;
+        default:
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return scope->key;
+}
+
+/* Move map scope from key to value, or from value to the next key */
+static
+void map_next(
+    ecs_meta_scope_t *scope)
+{
+    if (scope->is_key) {
+        ecs_type_op_t *hdr = ecs_vector_first(scope->ops, ecs_type_op_t);
+        ecs_size_t size = hdr->size;
+
+        scope->key = map_key(scope);
+
+        void *ptr = _ecs_map_get(scope->map, size, scope->key);
+        if (!ptr) {
+            if (size <= ECS_SIZEOF(zero_element)) {
+                _ecs_map_set(scope->map, size, scope->key, zero_element);
+            } else {
+                void *zero = ecs_os_calloc(size);
+                _ecs_map_set(scope->map, size, scope->key, zero);
+                ecs_os_free(zero);
+            }
+            ptr = _ecs_map_get(scope->map, size, scope->key);
+        }
+
+        scope->base = ptr;
+        scope->is_key = false;
+    } else {
+        scope->base = NULL;
+        scope->key = 0;
+        scope->is_key = true;
+    }
+
+    scope->cur_op = 1;
+}
+
 int ecs_meta_next(
     ecs_meta_cursor_t *cursor)
 {
     ecs_meta_scope_t *scope = get_scope(cursor);
+
+    if (scope->map) {
+        map_next(scope);
+        return 0;
+    }
     int32_t ops_count = ecs_vector_count(scope->ops);
 
     if (scope->count) {
@@ -126,6 +306,19 @@ int ecs_meta_move_name(
     const char *name)
 {
     ecs_meta_scope_t *scope = get_scope(cursor);
+
+    if (scope->members) {
+        int32_t op = ecs_meta_find_member(
+            scope->members, scope->ops, scope->start, name);
+        if (op == -1) {
+            return -1;
+        }
+
+        scope->cur_op = op;
+        return 0;
+    }
+
+    /* Ops without index */
     ecs_type_op_t *ops = ecs_vector_first(scope->ops, ecs_type_op_t);
     int32_t i, ops_count = ecs_vector_count(scope->ops);
     int32_t depth = 1;
@@ -155,8 +348,10 @@ int ecs_meta_move_name(
     return -1;
 }
 
-int ecs_meta_push(
-    ecs_meta_cursor_t *cursor)
+static
+int push(
+    ecs_meta_cursor_t *cursor,
+    int32_t capacity)
 {
     ecs_meta_scope_t *scope = get_scope(cursor);
     ecs_type_op_t *op = get_op(scope);
@@ -166,6 +361,10 @@ int ecs_meta_push(
         get_ptr(scope);
     }
     
+    if ((cursor->depth + 1) >= cursor->max_depth) {
+        return -1;
+    }
+
     scope->cur_op ++;
     cursor->depth ++;
     ecs_meta_scope_t *child_scope = get_scope(cursor);
@@ -177,6 +376,9 @@ int ecs_meta_push(
         child_scope->start = scope->cur_op;
         child_scope->cur_op = scope->cur_op;
         child_scope->ops = scope->ops;
+        child_scope->members = scope->members;
+        child_scope->map = NULL;
+        child_scope->is_key = false;
         child_scope->is_collection = false;
         child_scope->count = 0;
         child_scope->vector = NULL;
@@ -185,11 +387,9 @@ int ecs_meta_push(
     case EcsOpArray:
     case EcsOpVector: {
         void *ptr = ECS_OFFSET(scope->base, op->offset);
-        const EcsMetaTypeSerializer *ser = ecs_get_ref_w_entity(cursor->world, 
-            &op->is.collection, 0, 0);
-        ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
-
-        ecs_vector_t *ops = ser->ops;
+        ecs_vector_t *ops = ecs_type_op_ref_get(
+            cursor->world, &op->is.collection);
+        ecs_assert(ops != NULL, ECS_INTERNAL_ERROR, NULL);
 
         if (op->kind == EcsOpArray) {
             child_scope->base = ptr;
@@ -198,9 +398,12 @@ int ecs_meta_push(
         } else {
             ecs_vector_t *v = *(ecs_vector_t**)ptr;
             if (!v) {
-                v = ecs_vector_new_t(op->size, op->alignment, 2);
+                v = ecs_vector_new_t(op->size, op->alignment, capacity);
             } else {
                 ecs_vector_set_count_t(&v, op->size, op->alignment, 0);
+                if (ecs_vector_size(v) < capacity) {
+                    ecs_vector_set_size_t(&v, op->size, op->alignment, capacity);
+                }
             }
             
             child_scope->base = ecs_vector_first_t(v, op->size, op->alignment);
@@ -210,6 +413,10 @@ int ecs_meta_push(
         child_scope->start = 1;
         child_scope->cur_op = 1;
         child_scope->ops = ops;
+        child_scope->members = ecs_type_op_ref_serializer(
+            cursor->world, &op->is.collection)->members;
+        child_scope->map = NULL;
+        child_scope->is_key = false;
         child_scope->is_collection = true;
 #ifndef NDEBUG
         ecs_type_op_t *hdr = ecs_vector_first(child_scope->ops, ecs_type_op_t);
@@ -217,6 +424,56 @@ int ecs_meta_push(
 #endif
         }
         break;
+    case EcsOpMap: {
+        ecs_map_t **ptr = ECS_OFFSET(scope->base, op->offset);
+        ecs_vector_t *key_ops = ecs_type_op_ref_get(
+            cursor->world, &op->is.map.key);
+        ecs_vector_t *elem_ops = ecs_type_op_ref_get(
+            cursor->world, &op->is.map.element);
+        ecs_assert(key_ops != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(elem_ops != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        /* 2 instructions, one for the header */
+        ecs_assert(ecs_vector_count(key_ops) == 2, ECS_INTERNAL_ERROR, NULL);
+
+        ecs_type_op_t *hdr = ecs_vector_first(elem_ops, ecs_type_op_t);
+        ecs_assert(hdr->kind == EcsOpHeader, ECS_INTERNAL_ERROR, NULL);
+
+        const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+            cursor->world, &op->is.map.element);
+
+        if (!*ptr) {
+            *ptr = _ecs_map_new(hdr->size, hdr->alignment, capacity);
+        } else {
+            /* Elements of a value decoded into an arena don't own resources */
+            if (elem->owns_heap && !cursor->arena) {
+                ecs_map_iter_t it = ecs_map_iter(*ptr);
+                ecs_map_key_t key;
+                void *elem_ptr;
+                while ((elem_ptr = _ecs_map_next(&it, hdr->size, &key))) {
+                    ecs_meta_fini_values(
+                        cursor->world, elem->opt_ops, elem_ptr, 0, 1);
+                }
+            }
+
+            ecs_map_clear(*ptr);
+            ecs_map_grow(*ptr, capacity);
+        }
+
+        child_scope->base = NULL;
+        child_scope->count = 0;
+        child_scope->vector = NULL;
+        child_scope->start = 1;
+        child_scope->cur_op = 1;
+        child_scope->ops = elem_ops;
+        child_scope->members = elem->members;
+        child_scope->map = *ptr;
+        child_scope->key_ops = key_ops;
+        child_scope->key = 0;
+        child_scope->is_key = true;
+        child_scope->is_collection = true;
+        break;
+    }
     default:
         return -1;
     }
@@ -224,6 +481,32 @@ int ecs_meta_push(
     return 0;
 }
 
+int ecs_meta_push(
+    ecs_meta_cursor_t *cursor)
+{
+    return push(cursor, 2);
+}
+
+int ecs_meta_push_n(
+    ecs_meta_cursor_t *cursor,
+    int32_t count)
+{
+    ecs_assert(count >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_op(scope);
+
+    if (op->kind == EcsOpArray) {
+        if (count > op->count) {
+            return -1;
+        }
+    } else if (op->kind != EcsOpVector && op->kind != EcsOpMap) {
+        return -1;
+    }
+
+    return push(cursor, count > 2 ? count : 2);
+}
+
 int ecs_meta_pop(
     ecs_meta_cursor_t *cursor)
 {
@@ -248,7 +531,9 @@ int ecs_meta_pop(
             if (op->kind == EcsOpPop) {
                 cursor->depth -- ;                
                 ecs_meta_scope_t *parent_scope = get_scope(cursor);
-                if (parent_scope->is_collection) {
+                if (parent_scope->map) {
+                    map_next(parent_scope);
+                } else if (parent_scope->is_collection) {
                     parent_scope->cur_op = 1;
                     parent_scope->cur_elem ++;
                 } else {
@@ -428,6 +713,217 @@ int ecs_meta_set_float(
     }
 }
 
+/* Get primitive element op of a collection scope, if the scope has space for
+ * count elements starting at the current element */
+static
+ecs_type_op_t* get_array_op(
+    ecs_meta_scope_t *scope,
+    int32_t count)
+{
+    ecs_assert(count >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    if (!scope->is_collection || scope->map) {
+        return NULL;
+    }
+
+    ecs_type_op_t *op = get_op(scope);
+    if (op->kind != EcsOpPrimitive) {
+        return NULL;
+    }
+
+    if (scope->count && (scope->cur_elem + count) > scope->count) {
+        return NULL;
+    }
+
+    return op;
+}
+
+/* Get pointer to count elements starting at the current element, and move the
+ * cursor to the last element */
+static
+void* get_array_ptr(
+    ecs_meta_scope_t *scope,
+    ecs_type_op_t *op,
+    int32_t count)
+{
+    int32_t first = scope->cur_elem;
+
+    if (scope->vector) {
+        _ecs_vector_set_min_count(&scope->vector, 
+            ECS_VECTOR_U(op->size, op->alignment), first + count);
+        scope->base = ecs_vector_first_t(
+            scope->vector, op->size, op->alignment);
+    }
+
+    scope->cur_elem += count - 1;
+
+    return ECS_OFFSET(scope->base, op->offset + op->size * first);
+}
+
+/* Range checks test the smallest and largest value, which unlike an early out
+ * per element lets the compiler vectorize the loop */
+static
+bool int_array_in_range(
+    const int64_t *values,
+    int32_t count,
+    int64_t min,
+    int64_t max)
+{
+    int64_t lo = INT64_MAX, hi = INT64_MIN;
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+    }
+
+    return lo >= min && hi <= max;
+}
+
+static
+bool uint_array_in_range(
+    const uint64_t *values,
+    int32_t count,
+    uint64_t max)
+{
+    uint64_t hi = 0;
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        hi = values[i] > hi ? values[i] : hi;
+    }
+
+    return hi <= max;
+}
+
+#define ARRAY_COPY(T, dst, src, count)\
+    for (i = 0; i < count; i ++) {\
+        ((T*)dst)[i] = (T)src[i];\
+    }
+
+int ecs_meta_set_int_array(
+    ecs_meta_cursor_t *cursor,
+    const int64_t *values,
+    int32_t count)
+{
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_array_op(scope, count);
+    if (!op) {
+        return -1;
+    }
+
+    if (!count) {
+        return 0;
+    }
+
+    int64_t min, max;
+    switch(op->is.primitive) {
+    case EcsI8: min = INT8_MIN; max = INT8_MAX; break;
+    case EcsI16: min = INT16_MIN; max = INT16_MAX; break;
+    case EcsI32: min = INT32_MIN; max = INT32_MAX; break;
+    case EcsI64: min = INT64_MIN; max = INT64_MAX; break;
+    case EcsIPtr: min = INTPTR_MIN; max = INTPTR_MAX; break;
+    default:
+        return -1;
+    }
+
+    if (!int_array_in_range(values, count, min, max)) {
+        return -1;
+    }
+
+    void *ptr = get_array_ptr(scope, op, count);
+    int32_t i;
+
+    switch(op->is.primitive) {
+    case EcsI8: ARRAY_COPY(int8_t, ptr, values, count); break;
+    case EcsI16: ARRAY_COPY(int16_t, ptr, values, count); break;
+    case EcsI32: ARRAY_COPY(int32_t, ptr, values, count); break;
+    case EcsI64: ARRAY_COPY(int64_t, ptr, values, count); break;
+    case EcsIPtr: ARRAY_COPY(intptr_t, ptr, values, count); break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+int ecs_meta_set_uint_array(
+    ecs_meta_cursor_t *cursor,
+    const uint64_t *values,
+    int32_t count)
+{
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_array_op(scope, count);
+    if (!op) {
+        return -1;
+    }
+
+    if (!count) {
+        return 0;
+    }
+
+    uint64_t max;
+    switch(op->is.primitive) {
+    case EcsU8: 
+    case EcsByte: max = UINT8_MAX; break;
+    case EcsU16: max = UINT16_MAX; break;
+    case EcsU32: max = UINT32_MAX; break;
+    case EcsU64: max = UINT64_MAX; break;
+    case EcsUPtr: max = UINTPTR_MAX; break;
+    default:
+        return -1;
+    }
+
+    if (!uint_array_in_range(values, count, max)) {
+        return -1;
+    }
+
+    void *ptr = get_array_ptr(scope, op, count);
+    int32_t i;
+
+    switch(op->is.primitive) {
+    case EcsU8: 
+    case EcsByte: ARRAY_COPY(uint8_t, ptr, values, count); break;
+    case EcsU16: ARRAY_COPY(uint16_t, ptr, values, count); break;
+    case EcsU32: ARRAY_COPY(uint32_t, ptr, values, count); break;
+    case EcsU64: ARRAY_COPY(uint64_t, ptr, values, count); break;
+    case EcsUPtr: ARRAY_COPY(uintptr_t, ptr, values, count); break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+int ecs_meta_set_float_array(
+    ecs_meta_cursor_t *cursor,
+    const double *values,
+    int32_t count)
+{
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_array_op(scope, count);
+    if (!op) {
+        return -1;
+    }
+
+    if (op->is.primitive != EcsF32 && op->is.primitive != EcsF64) {
+        return -1;
+    }
+
+    if (!count) {
+        return 0;
+    }
+
+    void *ptr = get_array_ptr(scope, op, count);
+    int32_t i;
+
+    if (op->is.primitive == EcsF32) {
+        ARRAY_COPY(float, ptr, values, count);
+    } else {
+        ecs_os_memcpy(ptr, values, ECS_SIZEOF(double) * count);
+    }
+
+    return 0;
+}
+
 int ecs_meta_set_string(
     ecs_meta_cursor_t *cursor,
     const char *value)
@@ -442,6 +938,26 @@ int ecs_meta_set_string(
 
         switch(op->is.primitive) {
         case EcsString:
+            if (cursor->arena) {
+                /* Previous value is not owned when decoding into an arena. A
+                 * string that is not from the arena means that the value owns
+                 * its strings, which would leak here and later free arena
+                 * memory in its destructor. */
+                ecs_assert(!*(char**)ptr ||
+                    ecs_meta_arena_owns(cursor->arena, *(char**)ptr),
+                    ECS_INVALID_PARAMETER, NULL);
+
+                if (value) {
+                    ecs_size_t len = ecs_os_strlen(value) + 1;
+                    char *str = ecs_meta_arena_alloc(cursor->arena, len);
+                    ecs_os_memcpy(str, value, len);
+                    *(char**)ptr = str;
+                } else {
+                    *(char**)ptr = NULL;
+                }
+                break;
+            }
+
             if (*(char**)ptr) {
                 ecs_os_free(*(char**)ptr);
             }
@@ -460,6 +976,56 @@ int ecs_meta_set_string(
     }
 }
 
+int ecs_meta_set_enum_name(
+    ecs_meta_cursor_t *cursor,
+    const char *value)
+{
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_op(scope);
+
+    if (op->kind != EcsOpEnum) {
+        return -1;
+    } else {
+        const EcsEnum *enum_type = ecs_get_ref_w_entity(
+            cursor->world, &op->is.constant, 0, 0);
+        ecs_assert(enum_type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        int32_t result;
+        if (ecs_meta_enum_value(enum_type, value, &result)) {
+            return -1;
+        }
+
+        void *ptr = get_ptr(scope);
+        *(int32_t*)ptr = result;
+        return 0;
+    }
+}
+
+int ecs_meta_set_bitmask_names(
+    ecs_meta_cursor_t *cursor,
+    const char *value)
+{
+    ecs_meta_scope_t *scope = get_scope(cursor);
+    ecs_type_op_t *op = get_op(scope);
+
+    if (op->kind != EcsOpBitmask) {
+        return -1;
+    } else {
+        const EcsBitmask *bitmask_type = ecs_get_ref_w_entity(
+            cursor->world, &op->is.constant, 0, 0);
+        ecs_assert(bitmask_type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        uint32_t result;
+        if (ecs_meta_bitmask_value(bitmask_type, value, &result)) {
+            return -1;
+        }
+
+        void *ptr = get_ptr(scope);
+        *(uint32_t*)ptr = result;
+        return 0;
+    }
+}
+
 int ecs_meta_set_entity(
     ecs_meta_cursor_t *cursor,
     ecs_entity_t value)
@@ -499,10 +1065,14 @@ int ecs_meta_set_null(
 
         void *ptr = get_ptr(scope);
         char *str = *(char**)ptr;
-        if (str) {
+        if (str && !cursor->arena) {
             ecs_os_free(str);
         }
 
+        ecs_assert(!str || !cursor->arena ||
+            ecs_meta_arena_owns(cursor->arena, str),
+            ECS_INVALID_PARAMETER, NULL);
+
         *(char**)ptr = NULL;
         break;
     }
@@ -511,6 +1081,16 @@ int ecs_meta_set_null(
         void *ptr = get_ptr(scope);
         ecs_vector_t *vec = *(ecs_vector_t**)ptr;
         if (vec) {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                cursor->world, &op->is.collection);
+
+            /* Elements of a value decoded into an arena don't own resources */
+            if (elem->owns_heap && !cursor->arena) {
+                ecs_meta_fini_values(cursor->world, elem->opt_ops, 
+                    ecs_vector_first_t(vec, op->size, op->alignment), 
+                    op->size, ecs_vector_count(vec));
+            }
+
             ecs_vector_free(vec);
         }
 
@@ -518,6 +1098,32 @@ int ecs_meta_set_null(
         break;
     }
 
+    case EcsOpMap: {
+        void *ptr = get_ptr(scope);
+        ecs_map_t *map = *(ecs_map_t**)ptr;
+        if (map) {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                cursor->world, &op->is.map.element);
+
+            if (elem->owns_heap && !cursor->arena) {
+                ecs_type_op_t *hdr = ecs_vector_first(
+                    elem->opt_ops, ecs_type_op_t);
+                ecs_map_iter_t it = ecs_map_iter(map);
+                ecs_map_key_t key;
+                void *elem_ptr;
+                while ((elem_ptr = _ecs_map_next(&it, hdr->size, &key))) {
+                    ecs_meta_fini_values(
+                        cursor->world, elem->opt_ops, elem_ptr, 0, 1);
+                }
+            }
+
+            ecs_map_free(map);
+        }
+
+        *(ecs_map_t**)ptr = NULL;
+        break;
+    }
+
     default:
         return -1;
         break;
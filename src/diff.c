@@ -0,0 +1,261 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "binary.h"
+
+/* A delta starts with a bitmask with a bit for each member of the type, which
+ * is set if the member changed. The bitmask is followed by the binary encoded
+ * values of the changed members. Vector members are encoded as the new element
+ * count, a bitmask for the elements both values have in common, the changed
+ * elements and the appended elements. Types that are not structs are treated
+ * as a struct with a single member. */
+
+typedef struct member_range_t {
+    int32_t start;
+    int32_t count;
+} member_range_t;
+
+/* Find the op ranges of the top-level members of a type */
+static
+ecs_vector_t* get_members(
+    ecs_vector_t *ops)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ops);
+    ecs_vector_t *result = NULL;
+    member_range_t *m;
+
+    if (count < 2 || op[1].kind != EcsOpPush) {
+        m = ecs_vector_add(&result, member_range_t);
+        m->start = 1;
+        m->count = count - 1;
+        return result;
+    }
+
+    int32_t depth = 0;
+    for (i = 2; i < count - 1; i ++) {
+        if (!depth) {
+            m = ecs_vector_add(&result, member_range_t);
+            m->start = i;
+        }
+
+        if (op[i].kind == EcsOpPush) {
+            depth ++;
+        } else if (op[i].kind == EcsOpPop) {
+            depth --;
+        }
+
+        if (!depth) {
+            m->count = i - m->start + 1;
+        }
+    }
+
+    return result;
+}
+
+static
+void diff_vector(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    const ecs_vector_t *old_vec,
+    const ecs_vector_t *new_vec,
+    ecs_vector_t **out)
+{
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.collection);
+    ecs_vector_t *elem_ops = ECS_META_BIN_OPS(elem);
+
+    ecs_vector_t *eq_vec = ecs_meta_compare_ops(elem);
+    ecs_type_op_t *eq_ops = ecs_vector_first(eq_vec, ecs_type_op_t);
+    int32_t eq_op_count = ecs_vector_count(eq_vec);
+
+    int32_t old_count = ecs_vector_count(old_vec);
+    int32_t new_count = ecs_vector_count(new_vec);
+    int32_t i, common = old_count < new_count ? old_count : new_count;
+    void *old_first = ecs_vector_first_t(old_vec, op->size, op->alignment);
+    void *new_first = ecs_vector_first_t(new_vec, op->size, op->alignment);
+
+    ecs_meta_bin_write_u32(out, (uint32_t)new_count);
+
+    /* Bitmask of changed elements */
+    int32_t mask_size = (common + 7) / 8;
+    int32_t mask_offset = ecs_vector_count(*out);
+    uint8_t *mask = ecs_vector_addn(out, uint8_t, mask_size);
+    ecs_os_memset(mask, 0, mask_size);
+
+    for (i = 0; i < common; i ++) {
+        void *old_elem = ECS_OFFSET(old_first, i * op->size);
+        void *new_elem = ECS_OFFSET(new_first, i * op->size);
+        if (!ecs_meta_ops_equal(world, eq_ops, eq_op_count, old_elem, new_elem)) {
+            /* Vector may have been reallocated */
+            mask = ecs_vector_get(*out, uint8_t, mask_offset);
+            mask[i / 8] |= (uint8_t)(1 << (i % 8));
+
+            ecs_meta_bin_write(world, ecs_vector_first(elem_ops, ecs_type_op_t),
+                ecs_vector_count(elem_ops), new_elem, out);
+        }
+    }
+
+    /* Appended elements */
+    for (; i < new_count; i ++) {
+        ecs_meta_bin_write(world, ecs_vector_first(elem_ops, ecs_type_op_t),
+            ecs_vector_count(elem_ops), ECS_OFFSET(new_first, i * op->size),
+            out);
+    }
+}
+
+static
+int patch_vector(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    ecs_vector_t **vec,
+    ecs_meta_bin_reader_t *reader)
+{
+    const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+        world, &op->is.collection);
+    ecs_vector_t *elem_ops = ECS_META_BIN_OPS(elem);
+
+    uint32_t new_count;
+    if (ecs_meta_bin_read_u32(reader, &new_count)) {
+        return -1;
+    }
+
+    if (!reader->trusted && new_count > ECS_MAX_I32) {
+        return -1;
+    }
+
+    int32_t old_count = ecs_vector_count(*vec);
+    int32_t count = (int32_t)new_count;
+    int32_t i, common = old_count < count ? old_count : count;
+
+    const uint8_t *mask = reader->ptr;
+    int32_t mask_size = (common + 7) / 8;
+    if (!reader->trusted && (reader->end - reader->ptr) < mask_size) {
+        return -1;
+    }
+
+    /* Appended elements are always encoded, which bounds the new count by the
+     * size of the remaining input */
+    if (!reader->trusted && count > old_count) {
+        uint64_t min_size = (uint64_t)ecs_meta_bin_min_size(world, elem_ops);
+        if ((uint64_t)(count - old_count) * min_size >
+            (uint64_t)(reader->end - reader->ptr - mask_size))
+        {
+            return -1;
+        }
+    }
+    reader->ptr += mask_size;
+
+    ecs_meta_bin_resize_vector(world, op, vec, count);
+    void *first = ecs_vector_first_t(*vec, op->size, op->alignment);
+
+    for (i = 0; i < count; i ++) {
+        if (i < common && !(mask[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
+
+        if (ecs_meta_bin_read(world, ecs_vector_first(elem_ops, ecs_type_op_t),
+            ecs_vector_count(elem_ops), ECS_OFFSET(first, i * op->size),
+            reader))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int ecs_meta_diff(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *old_value,
+    const void *new_value,
+    ecs_vector_t **out)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+
+    ecs_vector_t *members = get_members(ser->ops);
+    member_range_t *m = ecs_vector_first(members, member_range_t);
+    int32_t i, count = ecs_vector_count(members);
+
+    int32_t mask_size = (count + 7) / 8;
+    int32_t mask_offset = ecs_vector_count(*out);
+    uint8_t *mask = ecs_vector_addn(out, uint8_t, mask_size);
+    ecs_os_memset(mask, 0, mask_size);
+
+    for (i = 0; i < count; i ++) {
+        ecs_type_op_t *op = &ops[m[i].start];
+        if (ecs_meta_ops_equal(world, op, m[i].count, old_value, new_value)) {
+            continue;
+        }
+
+        mask = ecs_vector_get(*out, uint8_t, mask_offset);
+        mask[i / 8] |= (uint8_t)(1 << (i % 8));
+
+        if (m[i].count == 1 && op->kind == EcsOpVector) {
+            diff_vector(world, op,
+                *(ecs_vector_t**)ECS_OFFSET(old_value, op->offset),
+                *(ecs_vector_t**)ECS_OFFSET(new_value, op->offset), out);
+        } else {
+            ecs_meta_bin_write(world, op, m[i].count, new_value, out);
+        }
+    }
+
+    ecs_vector_free(members);
+
+    return 0;
+}
+
+int ecs_meta_patch(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *value,
+    const void *delta,
+    ecs_size_t size)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+
+    ecs_vector_t *members = get_members(ser->ops);
+    member_range_t *m = ecs_vector_first(members, member_range_t);
+    int32_t i, count = ecs_vector_count(members);
+
+    ecs_meta_bin_reader_t reader = {
+        .ptr = delta,
+        .end = ECS_OFFSET(delta, size)
+    };
+
+    int32_t mask_size = (count + 7) / 8;
+    const uint8_t *mask = reader.ptr;
+    if ((reader.end - reader.ptr) < mask_size) {
+        goto error;
+    }
+    reader.ptr += mask_size;
+
+    for (i = 0; i < count; i ++) {
+        if (!(mask[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
+
+        ecs_type_op_t *op = &ops[m[i].start];
+
+        if (m[i].count == 1 && op->kind == EcsOpVector) {
+            if (patch_vector(world, op,
+                ECS_OFFSET(value, op->offset), &reader))
+            {
+                goto error;
+            }
+        } else {
+            if (ecs_meta_bin_read(world, op, m[i].count, value, &reader)) {
+                goto error;
+            }
+        }
+    }
+
+    ecs_vector_free(members);
+
+    return (int)(reader.ptr - (const uint8_t*)delta);
+error:
+    ecs_vector_free(members);
+    return -1;
+}
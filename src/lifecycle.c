@@ -0,0 +1,352 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "lifecycle.h"
+#include "world.h"
+
+/* The lifecycle actions walk the optimized ops of a type, so that plain data
+ * is skipped (dtor) or copied in bulk (copy, move). Each op is applied to all
+ * elements in the batch before moving on to the next op. */
+
+/* Actions are registered once per component and look up the serializer each
+ * time they are invoked, so they follow redefinitions of the type. Returns
+ * NULL if values don't own resources, or if the world is being deleted, in
+ * which case ecs_meta_fini_components has already released them. */
+static
+const EcsMetaTypeSerializer* get_serializer(
+    ecs_world_t *world,
+    ecs_entity_t component)
+{
+    if (ecs_meta_world_is_fini(world)) {
+        return NULL;
+    }
+
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(
+        world, component);
+    if (!ser || !ser->owns_heap) {
+        return NULL;
+    }
+
+    return ser;
+}
+
+void ecs_meta_fini_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    void *base,
+    ecs_size_t size,
+    int32_t count)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, op_count = ecs_vector_count(ops);
+    int32_t j;
+
+    for (i = 1; i < op_count; i ++) {
+        void *ptr = ECS_OFFSET(base, op[i].offset);
+
+        switch(op[i].kind) {
+        case EcsOpPrimitive:
+            if (op[i].is.primitive == EcsString) {
+                for (j = 0; j < count; j ++) {
+                    ecs_os_free(*(char**)ECS_OFFSET(ptr, j * size));
+                }
+            }
+            break;
+
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+            if (!elem->owns_heap) {
+                break;
+            }
+
+            for (j = 0; j < count; j ++) {
+                ecs_meta_fini_values(world, elem->opt_ops, 
+                    ECS_OFFSET(ptr, j * size), op[i].size, op[i].count);
+            }
+            break;
+        }
+
+        case EcsOpVector: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+
+            for (j = 0; j < count; j ++) {
+                ecs_vector_t *v = *(ecs_vector_t**)ECS_OFFSET(ptr, j * size);
+                if (elem->owns_heap) {
+                    ecs_meta_fini_values(world, elem->opt_ops,
+                        ecs_vector_first_t(v, op[i].size, op[i].alignment),
+                        op[i].size, ecs_vector_count(v));
+                }
+
+                ecs_vector_free(v);
+            }
+            break;
+        }
+
+        case EcsOpMap: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.map.element);
+
+            for (j = 0; j < count; j ++) {
+                ecs_map_t *m = *(ecs_map_t**)ECS_OFFSET(ptr, j * size);
+                if (elem->owns_heap) {
+                    ecs_map_iter_t it = ecs_map_iter(m);
+                    ecs_map_key_t key;
+                    void *elem_ptr;
+
+                    while ((elem_ptr = _ecs_map_next(&it, 0, &key))) {
+                        ecs_meta_fini_values(
+                            world, elem->opt_ops, elem_ptr, 0, 1);
+                    }
+                }
+
+                ecs_map_free(m);
+            }
+            break;
+        }
+
+        case EcsOpHeader:
+        case EcsOpEnum:
+        case EcsOpBitmask:
+        case EcsOpPush:
+        case EcsOpPop:
+        case EcsOpBlit:
+            break;
+        }
+    }
+}
+
+void ecs_meta_dup_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    void *base,
+    ecs_size_t size,
+    int32_t count)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, op_count = ecs_vector_count(ops);
+    int32_t j;
+
+    for (i = 1; i < op_count; i ++) {
+        void *ptr = ECS_OFFSET(base, op[i].offset);
+
+        switch(op[i].kind) {
+        case EcsOpPrimitive:
+            if (op[i].is.primitive == EcsString) {
+                for (j = 0; j < count; j ++) {
+                    char **str = ECS_OFFSET(ptr, j * size);
+                    if (*str) {
+                        *str = ecs_os_strdup(*str);
+                    }
+                }
+            }
+            break;
+
+        case EcsOpArray: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+            if (!elem->owns_heap) {
+                break;
+            }
+
+            for (j = 0; j < count; j ++) {
+                ecs_meta_dup_values(world, elem->opt_ops, 
+                    ECS_OFFSET(ptr, j * size), op[i].size, op[i].count);
+            }
+            break;
+        }
+
+        case EcsOpVector: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.collection);
+
+            for (j = 0; j < count; j ++) {
+                ecs_vector_t **v = ECS_OFFSET(ptr, j * size);
+                if (!*v) {
+                    continue;
+                }
+
+                *v = ecs_vector_copy_t(*v, op[i].size, op[i].alignment);
+                if (elem->owns_heap) {
+                    ecs_meta_dup_values(world, elem->opt_ops,
+                        ecs_vector_first_t(*v, op[i].size, op[i].alignment),
+                        op[i].size, ecs_vector_count(*v));
+                }
+            }
+            break;
+        }
+
+        case EcsOpMap: {
+            const EcsMetaTypeSerializer *elem = ecs_type_op_ref_serializer(
+                world, &op[i].is.map.element);
+
+            for (j = 0; j < count; j ++) {
+                ecs_map_t **m = ECS_OFFSET(ptr, j * size);
+                if (!*m) {
+                    continue;
+                }
+
+                *m = ecs_map_copy(*m);
+                if (elem->owns_heap) {
+                    ecs_map_iter_t it = ecs_map_iter(*m);
+                    ecs_map_key_t key;
+                    void *elem_ptr;
+
+                    while ((elem_ptr = _ecs_map_next(&it, 0, &key))) {
+                        ecs_meta_dup_values(
+                            world, elem->opt_ops, elem_ptr, 0, 1);
+                    }
+                }
+            }
+            break;
+        }
+
+        case EcsOpHeader:
+        case EcsOpEnum:
+        case EcsOpBitmask:
+        case EcsOpPush:
+        case EcsOpPop:
+        case EcsOpBlit:
+            break;
+        }
+    }
+}
+
+void ecs_meta_lifecycle_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *entities,
+    void *ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)entities;
+    (void)ctx;
+
+    const EcsMetaTypeSerializer *ser = get_serializer(world, component);
+    if (ser) {
+        ecs_meta_fini_values(world, ser->opt_ops, ptr, (ecs_size_t)size, count);
+    }
+}
+
+void ecs_meta_lifecycle_copy(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entities,
+    const ecs_entity_t *src_entities,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)dst_entities;
+    (void)src_entities;
+    (void)ctx;
+
+    const EcsMetaTypeSerializer *ser = get_serializer(world, component);
+    if (!ser) {
+        memcpy(dst_ptr, src_ptr, size * (size_t)count);
+        return;
+    }
+
+    /* Destination values are constructed, so release what they own first */
+    ecs_meta_fini_values(world, ser->opt_ops, dst_ptr, (ecs_size_t)size, count);
+    memcpy(dst_ptr, src_ptr, size * (size_t)count);
+    ecs_meta_dup_values(world, ser->opt_ops, dst_ptr, (ecs_size_t)size, count);
+}
+
+void ecs_meta_lifecycle_move(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entities,
+    const ecs_entity_t *src_entities,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)dst_entities;
+    (void)src_entities;
+    (void)ctx;
+
+    const EcsMetaTypeSerializer *ser = get_serializer(world, component);
+    if (!ser) {
+        memcpy(dst_ptr, src_ptr, size * (size_t)count);
+        return;
+    }
+
+    /* Ownership is transferred to the destination. Reset source values to the
+     * state set by the constructor, so destructing them is a no-op. */
+    ecs_meta_fini_values(world, ser->opt_ops, dst_ptr, (ecs_size_t)size, count);
+    memcpy(dst_ptr, src_ptr, size * (size_t)count);
+    memset(src_ptr, 0, size * (size_t)count);
+}
+
+static
+void ctor_initialize_0(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *entities,
+    void *ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    (void)world;
+    (void)component;
+    (void)entities;
+    (void)ctx;
+    memset(ptr, 0, size * (size_t)count);
+}
+
+void ecs_meta_init_lifecycle(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const EcsMetaTypeSerializer *ser)
+{
+    (void)ser;
+
+    /* Actions are the same for every definition of the type, so they only
+     * need to be registered once */
+    if (!ecs_meta_add_component(world, component)) {
+        return;
+    }
+
+    ecs_set_component_actions_w_entity(world, component, 
+        &(EcsComponentLifecycle){
+            .ctor = ctor_initialize_0,
+            .dtor = ecs_meta_lifecycle_dtor,
+            .copy = ecs_meta_lifecycle_copy,
+            .move = ecs_meta_lifecycle_move
+        });
+}
+
+void ecs_meta_fini_components(
+    ecs_world_t *world,
+    ecs_vector_t *components)
+{
+    ecs_vector_each(components, ecs_entity_t, c, {
+        const EcsMetaTypeSerializer *ser = get_serializer(world, *c);
+        if (!ser) {
+            continue;
+        }
+
+        ecs_type_op_t *hdr = ecs_vector_first(ser->opt_ops, ecs_type_op_t);
+        ecs_filter_t filter = {
+            .include = ecs_type_from_entity(world, *c)
+        };
+
+        ecs_iter_t it = ecs_filter_iter(world, &filter);
+        while (ecs_filter_next(&it)) {
+            int32_t index = ecs_type_index_of(ecs_iter_type(&it), *c);
+            void *ptr = ecs_table_column(&it, index);
+
+            /* Reset values so the destructor invoked by ecs_fini is a no-op */
+            ecs_meta_fini_values(world, ser->opt_ops, ptr, hdr->size, it.count);
+            memset(ptr, 0, (size_t)(hdr->size * it.count));
+        }
+    });
+}
@@ -0,0 +1,70 @@
+#ifndef FLECS_META_LIFECYCLE_H
+#define FLECS_META_LIFECYCLE_H
+
+#include "flecs_meta.h"
+
+/* Free resources owned by values */
+void ecs_meta_fini_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    void *base,
+    ecs_size_t size,
+    int32_t count);
+
+/* Replace resources in values that were copied bytewise with deep copies */
+void ecs_meta_dup_values(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    void *base,
+    ecs_size_t size,
+    int32_t count);
+
+/* Component actions generated from the type serializer. Actions look up the
+ * current serializer of the component, and copy bytes for types that don't
+ * own resources. */
+
+void ecs_meta_lifecycle_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *entities,
+    void *ptr,
+    size_t size,
+    int32_t count,
+    void *ctx);
+
+void ecs_meta_lifecycle_copy(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entities,
+    const ecs_entity_t *src_entities,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx);
+
+void ecs_meta_lifecycle_move(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entities,
+    const ecs_entity_t *src_entities,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx);
+
+/* Register component actions for a type. The constructor zero-initializes,
+ * so that values can be released by the other actions. */
+void ecs_meta_init_lifecycle(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const EcsMetaTypeSerializer *ser);
+
+/* Release resources owned by all values of components, and reset the values.
+ * Called when the world is deleted, while serializers still exist. */
+void ecs_meta_fini_components(
+    ecs_world_t *world,
+    ecs_vector_t *components);
+
+#endif
@@ -1,7 +1,9 @@
 #include <flecs_meta.h>
 #include "parser.h"
 #include "serializer.h"
+#include "lifecycle.h"
 #include "type.h"
+#include "world.h"
 
 ECS_CTOR(EcsStruct, ptr, {
     ptr->members = NULL;
@@ -17,9 +19,13 @@ ECS_DTOR(EcsStruct, ptr, {
 
 ECS_CTOR(EcsEnum, ptr, {
     ptr->constants = NULL;
+    ptr->min_value = 0;
+    ptr->names = NULL;
+    ptr->values = NULL;
 })
 
 ECS_DTOR(EcsEnum, ptr, {
+    ecs_meta_enum_fini(ptr);
     ecs_map_each(ptr->constants, char*, key, c_ptr, {
         ecs_os_free(*c_ptr);
     })
@@ -28,9 +34,13 @@ ECS_DTOR(EcsEnum, ptr, {
 
 ECS_CTOR(EcsBitmask, ptr, {
     ptr->constants = NULL;
+    ptr->bits = NULL;
+    ptr->compounds = NULL;
+    ptr->values = NULL;
 })
 
 ECS_DTOR(EcsBitmask, ptr, {
+    ecs_meta_bitmask_fini(ptr);
     ecs_map_each(ptr->constants, char*, key, c_ptr, {
         ecs_os_free(*c_ptr);
     })    
@@ -39,12 +49,41 @@ ECS_DTOR(EcsBitmask, ptr, {
 
 ECS_CTOR(EcsMetaTypeSerializer, ptr, {
     ptr->ops = NULL;
+    ptr->opt_ops = NULL;
+    ptr->members = NULL;
+    ptr->cmp_ops = NULL;
 })
 
 ECS_DTOR(EcsMetaTypeSerializer, ptr, {
+    ecs_meta_cache_serializer(world, entity_ptr[i], NULL);
     ecs_vector_free(ptr->ops);
+    ecs_vector_free(ptr->opt_ops);
+    ecs_map_free(ptr->members);
+    ecs_vector_free(ptr->cmp_ops);
 })
 
+static const struct {
+    const char *name;
+    ecs_primitive_kind_t kind;
+} primitive_descriptors[] = {
+    {"bool", EcsBool},
+    {"char", EcsChar},
+    {"u8", EcsU8},
+    {"u16", EcsU16},
+    {"u32", EcsU32},
+    {"u64", EcsU64},
+    {"i8", EcsI8},
+    {"i16", EcsI16},
+    {"i32", EcsI32},
+    {"i64", EcsI64},
+    {"f32", EcsF32},
+    {"f64", EcsF64},
+    {"iptr", EcsIPtr},
+    {"uptr", EcsUPtr},
+    {"string", EcsString},
+    {"entity", EcsEntity}
+};
+
 static
 void ecs_set_primitive(
     ecs_world_t *world, 
@@ -55,58 +94,21 @@ void ecs_set_primitive(
     ecs_assert(e != 0, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_entity_t ecs_entity(EcsPrimitive) = ecs_lookup_fullpath(world, "flecs.meta.Primitive");
-    ecs_assert(ecs_entity(EcsPrimitive) != 0, ECS_INTERNAL_ERROR, NULL);
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
 
     const char *descr = type->descriptor;
-
-    if (!strcmp(descr, "bool")) {
-        ecs_set(world, e, EcsPrimitive, {EcsBool});
-    } else
-    if (!strcmp(descr, "char")) {
-        ecs_set(world, e, EcsPrimitive, {EcsChar});
-    } else    
-    if (!strcmp(descr, "u8")) {
-        ecs_set(world, e, EcsPrimitive, {EcsU8});
-    } else
-    if (!strcmp(descr, "u8")) {
-        ecs_set(world, e, EcsPrimitive, {EcsU8});
-    } else
-    if (!strcmp(descr, "u16")) {
-        ecs_set(world, e, EcsPrimitive, {EcsU16});
-    } else
-    if (!strcmp(descr, "u32")) {
-        ecs_set(world, e, EcsPrimitive, {EcsU32});
-    } else
-    if (!strcmp(descr, "u64")) {
-        ecs_set(world, e, EcsPrimitive, {EcsU64});
-    } else
-    if (!strcmp(descr, "i8")) {
-        ecs_set(world, e, EcsPrimitive, {EcsI8});
-    } else
-    if (!strcmp(descr, "i16")) {
-        ecs_set(world, e, EcsPrimitive, {EcsI16});
-    } else
-    if (!strcmp(descr, "i32")) {
-        ecs_set(world, e, EcsPrimitive, {EcsI32});
-    } else
-    if (!strcmp(descr, "f32")) {
-        ecs_set(world, e, EcsPrimitive, {EcsF32});
-    } else
-    if (!strcmp(descr, "f64")) {
-        ecs_set(world, e, EcsPrimitive, {EcsF64});
-    } else
-    if (!strcmp(descr, "iptr")) {
-        ecs_set(world, e, EcsPrimitive, {EcsIPtr});
-    } else    
-    if (!strcmp(descr, "uptr")) {
-        ecs_set(world, e, EcsPrimitive, {EcsUPtr});
-    } else
-    if (!strcmp(descr, "string")) {
-        ecs_set(world, e, EcsPrimitive, {EcsString});
-    } else
-    if (!strcmp(descr, "entity")) {
-        ecs_set(world, e, EcsPrimitive, {EcsEntity});
+    int32_t i, count = sizeof(primitive_descriptors) / 
+        sizeof(primitive_descriptors[0]);
+
+    /* Only call strcmp for names that start with the same character */
+    for (i = 0; i < count; i ++) {
+        const char *name = primitive_descriptors[i].name;
+        if (name[0] == descr[0] && !strcmp(name, descr)) {
+            ecs_set(world, e, EcsPrimitive, {primitive_descriptors[i].kind});
+            break;
+        }
     }
 }
 
@@ -142,8 +144,15 @@ void ecs_set_constants(
                 "bitmask requires explicit value assignment");
         }
 
-        char *constant_name = ecs_os_strdup(token.name);
-        ecs_map_set(constants, last_value, &constant_name);
+        /* Enum constants are stored under sign extended keys, bitmask
+         * constants under zero extended keys, so that lookups by the value
+         * of the type find the same key for any spelling of the constant */
+        ecs_map_key_t key = is_bitmask
+            ? (ecs_map_key_t)(uint32_t)last_value
+            : (ecs_map_key_t)(int32_t)last_value;
+
+        char *constant_name = ecs_meta_token_dup(&token.name);
+        ecs_map_set(constants, key, &constant_name);
 
         last_value ++;
     }
@@ -159,9 +168,9 @@ void ecs_set_bitmask(
     ecs_entity_t e, 
     EcsMetaType *type) 
 {
-    ecs_entity_t comp = ecs_lookup_fullpath(world, "flecs.meta.Bitmask");
-    ecs_assert(comp != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_set_constants(world, e, comp, true, type);
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    ecs_set_constants(world, e, module->ecs_entity(EcsBitmask), true, type);
 }
 
 static
@@ -170,9 +179,9 @@ void ecs_set_enum(
     ecs_entity_t e, 
     EcsMetaType *type) 
 {
-    ecs_entity_t comp = ecs_lookup_fullpath(world, "flecs.meta.Enum");
-    ecs_assert(comp != 0, ECS_INTERNAL_ERROR, NULL);    
-    ecs_set_constants(world, e, comp, false, type);
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    ecs_set_constants(world, e, module->ecs_entity(EcsEnum), false, type);
 }
 
 static
@@ -199,15 +208,16 @@ void ecs_set_struct(
 
     while ((ptr = ecs_meta_parse_member(ptr, &token, &ctx))) {
         EcsMember *m = ecs_vector_add(&members, EcsMember);
-        m->name = ecs_os_strdup(token.name);
+        m->name = ecs_meta_token_dup(&token.name);
         m->type = ecs_meta_lookup(world, &token.type, ptr, token.count, &ctx);
         ecs_assert(type != 0, ECS_INTERNAL_ERROR, NULL);
     }
 
     is_partial = token.is_partial;
 
-    ecs_entity_t ecs_entity(EcsStruct) = ecs_lookup_fullpath(world, "flecs.meta.Struct");
-    ecs_assert(ecs_entity(EcsStruct) != 0, ECS_INTERNAL_ERROR, NULL);
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
     ecs_set(world, e, EcsStruct, {members, is_partial});
 }
 
@@ -338,31 +348,14 @@ void EcsSetType(ecs_iter_t *it) {
     }
 }
 
-static
-void ctor_initialize_0(
-    ecs_world_t *world,
-    ecs_entity_t component,
-    const ecs_entity_t *entities,
-    void *ptr,
-    size_t size,
-    int32_t count,
-    void *ctx)
-{
-    (void)world;
-    (void)component;
-    (void)entities;
-    (void)ctx;
-    memset(ptr, 0, size * (size_t)count);
-}
-
 void ecs_new_meta(
     ecs_world_t *world,
     ecs_entity_t component,
     EcsMetaType *meta_type)
 {
-    ecs_entity_t ecs_entity(EcsMetaType) = 
-        ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-    ecs_assert(ecs_entity(EcsMetaType) != 0, ECS_MODULE_UNDEFINED, "flecs.meta");
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
 
     if (meta_type->alias) {
         EcsMetaType *alias = meta_type->alias;
@@ -370,10 +363,19 @@ void ecs_new_meta(
         meta_type->descriptor = alias->descriptor;
     }
 
-    ecs_set_ptr(world, component, EcsMetaType, meta_type);\
-    ecs_set_component_actions_w_entity(world, component, &(EcsComponentLifecycle){
-        .ctor = ctor_initialize_0
-    });
+    /* If the type was loaded from a registry snapshot and the definition did
+     * not change since, it does not need to be parsed again */
+    const EcsMetaType *existing = ecs_get(world, component, EcsMetaType);
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, component, EcsMetaTypeSerializer);
+    if (!existing || !ser || !ecs_meta_type_equal(existing, meta_type)) {
+        ecs_set_ptr(world, component, EcsMetaType, meta_type);
+        ser = ecs_get(world, component, EcsMetaTypeSerializer);
+    }
+
+    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_meta_init_lifecycle(world, component, ser);
 }
 
 /* Utility macro to insert meta data for type with meta descriptor */
@@ -446,6 +448,28 @@ void FlecsMetaImport(
     ECS_EXPORT_COMPONENT(EcsMetaType);
     ECS_EXPORT_COMPONENT(EcsMetaTypeSerializer);  
 
+    /* Keep handles around so functions don't have to look them up by name */
+    ecs_meta_world_init(world, &(FlecsMeta){
+        .ecs_entity(EcsPrimitive) = ecs_entity(EcsPrimitive),
+        .ecs_type(EcsPrimitive) = ecs_type(EcsPrimitive),
+        .ecs_entity(EcsEnum) = ecs_entity(EcsEnum),
+        .ecs_type(EcsEnum) = ecs_type(EcsEnum),
+        .ecs_entity(EcsBitmask) = ecs_entity(EcsBitmask),
+        .ecs_type(EcsBitmask) = ecs_type(EcsBitmask),
+        .ecs_entity(EcsStruct) = ecs_entity(EcsStruct),
+        .ecs_type(EcsStruct) = ecs_type(EcsStruct),
+        .ecs_entity(EcsArray) = ecs_entity(EcsArray),
+        .ecs_type(EcsArray) = ecs_type(EcsArray),
+        .ecs_entity(EcsVector) = ecs_entity(EcsVector),
+        .ecs_type(EcsVector) = ecs_type(EcsVector),
+        .ecs_entity(EcsMap) = ecs_entity(EcsMap),
+        .ecs_type(EcsMap) = ecs_type(EcsMap),
+        .ecs_entity(EcsMetaType) = ecs_entity(EcsMetaType),
+        .ecs_type(EcsMetaType) = ecs_type(EcsMetaType),
+        .ecs_entity(EcsMetaTypeSerializer) = ecs_entity(EcsMetaTypeSerializer),
+        .ecs_type(EcsMetaTypeSerializer) = ecs_type(EcsMetaTypeSerializer)
+    });
+
     /* -- Initialize builtin primitive types -- */
     ecs_entity_t old_scope = ecs_set_scope(world, EcsFlecsCore);
     ECS_COMPONENT_PRIMITIVE(world, bool, EcsBool);
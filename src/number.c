@@ -0,0 +1,477 @@
+#include <flecs_meta.h>
+#include "number.h"
+
+/* Number formatting that writes directly to a buffer, and does not depend on
+ * the locale. Floating point numbers are written with the Grisu2 algorithm,
+ * which produces the shortest (or nearly shortest) sequence of digits that
+ * parses back to the same value. See "Printing Floating-Point Numbers Quickly
+ * and Accurately with Integers" by Florian Loitsch. */
+
+static const char digit_pairs[] = 
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+int32_t ecs_meta_u64_to_str(
+    char *buf,
+    uint64_t value)
+{
+    char tmp[20];
+    char *ptr = &tmp[20];
+
+    while (value >= 100) {
+        uint64_t index = (value % 100) * 2;
+        value /= 100;
+        *(--ptr) = digit_pairs[index + 1];
+        *(--ptr) = digit_pairs[index];
+    }
+
+    if (value >= 10) {
+        *(--ptr) = digit_pairs[value * 2 + 1];
+        *(--ptr) = digit_pairs[value * 2];
+    } else {
+        *(--ptr) = (char)('0' + value);
+    }
+
+    int32_t len = (int32_t)(&tmp[20] - ptr);
+    memcpy(buf, ptr, (size_t)len);
+    buf[len] = '\0';
+
+    return len;
+}
+
+int32_t ecs_meta_i64_to_str(
+    char *buf,
+    int64_t value)
+{
+    if (value < 0) {
+        buf[0] = '-';
+        /* Negate as unsigned, so that INT64_MIN does not overflow */
+        return 1 + ecs_meta_u64_to_str(&buf[1], 0 - (uint64_t)value);
+    }
+
+    return ecs_meta_u64_to_str(buf, (uint64_t)value);
+}
+
+/* -- Grisu2 -- */
+
+/* Floating point number with a 64 bit significand, value is f * 2^e */
+typedef struct diy_fp_t {
+    uint64_t f;
+    int32_t e;
+} diy_fp_t;
+
+/* Normalized powers of 10, from 10^-348 to 10^340 in steps of 8 */
+static const uint64_t cached_powers_f[] = {
+    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+    0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+    0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+    0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+    0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+    0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+    0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+    0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+    0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+    0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+    0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+    0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+    0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+    0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+    0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+    0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+    0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+    0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+    0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+    0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+    0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+    0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+};
+
+static const int16_t cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static
+diy_fp_t fp_multiply(
+    diy_fp_t x,
+    diy_fp_t y)
+{
+    const uint64_t M32 = 0xFFFFFFFF;
+    uint64_t a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1U << 31; /* Round */
+
+    return (diy_fp_t){
+        ac + (ad >> 32) + (bc >> 32) + (tmp >> 32),
+        x.e + y.e + 64
+    };
+}
+
+static
+diy_fp_t fp_normalize(
+    diy_fp_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    int32_t shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & ((uint64_t)1 << 63))) {
+        x.f <<= 1;
+        x.e --;
+    }
+#endif
+    return x;
+}
+
+/* Get normalized value and boundaries of the rounding interval of a value with
+ * the specified significand and exponent. Values that are between the
+ * boundaries parse back to the same floating point number. */
+static
+void fp_boundaries(
+    diy_fp_t v,
+    uint64_t hidden_bit,
+    diy_fp_t *w,
+    diy_fp_t *minus,
+    diy_fp_t *plus)
+{
+    diy_fp_t pl = fp_normalize((diy_fp_t){(v.f << 1) + 1, v.e - 1});
+    diy_fp_t mi;
+
+    /* The interval below a power of 2 is half as large */
+    if (v.f == hidden_bit) {
+        mi = (diy_fp_t){(v.f << 2) - 1, v.e - 2};
+    } else {
+        mi = (diy_fp_t){(v.f << 1) - 1, v.e - 1};
+    }
+
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    *w = fp_normalize(v);
+    *minus = mi;
+    *plus = pl;
+}
+
+/* Get cached power c = 10^-k such that the exponent of c * 2^e is in the
+ * range [-60, -32] */
+static
+diy_fp_t cached_power(
+    int32_t e,
+    int32_t *k)
+{
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int32_t ik = (int32_t)dk;
+    if (dk - ik > 0.0) {
+        ik ++;
+    }
+
+    int32_t index = (ik >> 3) + 1;
+    *k = -(-348 + (index << 3));
+
+    return (diy_fp_t){cached_powers_f[index], cached_powers_e[index]};
+}
+
+static
+void grisu_round(
+    char *buf,
+    int32_t len,
+    uint64_t delta,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+        (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        buf[len - 1] --;
+        rest += ten_kappa;
+    }
+}
+
+static
+int32_t count_digits(
+    uint32_t n)
+{
+    if (n < 10) return 1;
+    if (n < 100) return 2;
+    if (n < 1000) return 3;
+    if (n < 10000) return 4;
+    if (n < 100000) return 5;
+    if (n < 1000000) return 6;
+    if (n < 10000000) return 7;
+    if (n < 100000000) return 8;
+    return 9;
+}
+
+static
+int32_t digit_gen(
+    diy_fp_t w,
+    diy_fp_t mp,
+    uint64_t delta,
+    char *buf,
+    int32_t *k)
+{
+    static const uint32_t pow10[] = { 
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 
+        1000000000 
+    };
+
+    diy_fp_t one = {(uint64_t)1 << -mp.e, mp.e};
+    uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int32_t kappa = count_digits(p1);
+    int32_t len = 0;
+
+    /* Integral part */
+    while (kappa > 0) {
+        uint32_t div = pow10[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+
+        if (d || len) {
+            buf[len ++] = (char)('0' + d);
+        }
+
+        kappa --;
+
+        uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *k += kappa;
+            grisu_round(buf, len, delta, tmp, 
+                (uint64_t)pow10[kappa] << -one.e, wp_w);
+            return len;
+        }
+    }
+
+    /* Fractional part */
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+
+        char d = (char)(p2 >> -one.e);
+        if (d || len) {
+            buf[len ++] = (char)('0' + d);
+        }
+
+        p2 &= one.f - 1;
+        kappa --;
+
+        if (p2 < delta) {
+            *k += kappa;
+            int32_t index = -kappa;
+            grisu_round(buf, len, delta, p2, one.f, 
+                wp_w * (index < 9 ? pow10[index] : 0));
+            return len;
+        }
+    }
+}
+
+/* Produce digits of value, so that value is digits * 10^k */
+static
+int32_t grisu2(
+    diy_fp_t v,
+    uint64_t hidden_bit,
+    char *buf,
+    int32_t *k)
+{
+    diy_fp_t w, w_m, w_p;
+    fp_boundaries(v, hidden_bit, &w, &w_m, &w_p);
+
+    diy_fp_t c_mk = cached_power(w_p.e, k);
+    w = fp_multiply(w, c_mk);
+    w_p = fp_multiply(w_p, c_mk);
+    w_m = fp_multiply(w_m, c_mk);
+
+    /* Stay inside the interval if the multiplications were imprecise */
+    w_m.f ++;
+    w_p.f --;
+
+    return digit_gen(w, w_p, w_p.f - w_m.f, buf, k);
+}
+
+static
+int32_t write_exponent(
+    char *buf,
+    int32_t exp)
+{
+    int32_t len = 0;
+    if (exp < 0) {
+        buf[len ++] = '-';
+        exp = -exp;
+    }
+
+    return len + ecs_meta_u64_to_str(&buf[len], (uint64_t)exp);
+}
+
+/* Format digits in fixed notation if the number is not too large or small,
+ * and in exponent notation otherwise */
+static
+int32_t prettify(
+    char *buf,
+    int32_t len,
+    int32_t k)
+{
+    int32_t kk = len + k; /* 10^(kk - 1) <= v < 10^kk */
+    int32_t i;
+
+    if (k >= 0 && kk <= 21) {
+        /* 1234e7 -> 12340000000.0 */
+        for (i = len; i < kk; i ++) {
+            buf[i] = '0';
+        }
+        buf[kk] = '.';
+        buf[kk + 1] = '0';
+        return kk + 2;
+    } else if (kk > 0 && kk <= 21) {
+        /* 1234e-2 -> 12.34 */
+        memmove(&buf[kk + 1], &buf[kk], (size_t)(len - kk));
+        buf[kk] = '.';
+        return len + 1;
+    } else if (kk > -6 && kk <= 0) {
+        /* 1234e-6 -> 0.001234 */
+        int32_t offset = 2 - kk;
+        memmove(&buf[offset], &buf[0], (size_t)len);
+        buf[0] = '0';
+        buf[1] = '.';
+        for (i = 2; i < offset; i ++) {
+            buf[i] = '0';
+        }
+        return len + offset;
+    } else if (len == 1) {
+        /* 1e30 */
+        buf[1] = 'e';
+        return 2 + write_exponent(&buf[2], kk - 1);
+    } else {
+        /* 1234e30 -> 1.234e33 */
+        memmove(&buf[2], &buf[1], (size_t)(len - 1));
+        buf[1] = '.';
+        buf[len + 1] = 'e';
+        return len + 2 + write_exponent(&buf[len + 2], kk - 1);
+    }
+}
+
+static
+int32_t special_to_str(
+    char *buf,
+    bool negative,
+    bool is_nan,
+    bool is_zero)
+{
+    const char *str;
+    if (is_nan) {
+        str = "nan";
+    } else if (is_zero) {
+        str = negative ? "-0.0" : "0.0";
+    } else {
+        str = negative ? "-inf" : "inf";
+    }
+
+    int32_t len = ecs_os_strlen(str);
+    memcpy(buf, str, (size_t)len + 1);
+    return len;
+}
+
+int32_t ecs_meta_f64_to_str(
+    char *buf,
+    double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(double));
+
+    bool negative = (bits >> 63) != 0;
+    int32_t biased_e = (int32_t)((bits >> 52) & 0x7FF);
+    uint64_t significand = bits & 0x000FFFFFFFFFFFFFull;
+
+    if (biased_e == 0x7FF) {
+        return special_to_str(buf, negative, significand != 0, false);
+    }
+
+    if (!biased_e && !significand) {
+        return special_to_str(buf, negative, false, true);
+    }
+
+    const uint64_t hidden_bit = 0x0010000000000000ull;
+    diy_fp_t v;
+    if (biased_e) {
+        v = (diy_fp_t){significand + hidden_bit, biased_e - 1075};
+    } else {
+        v = (diy_fp_t){significand, -1074};
+    }
+
+    int32_t len = 0, k;
+    if (negative) {
+        buf[len ++] = '-';
+    }
+
+    int32_t digits = grisu2(v, hidden_bit, &buf[len], &k);
+    len += prettify(&buf[len], digits, k);
+    buf[len] = '\0';
+
+    return len;
+}
+
+int32_t ecs_meta_f32_to_str(
+    char *buf,
+    float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+
+    bool negative = (bits >> 31) != 0;
+    int32_t biased_e = (int32_t)((bits >> 23) & 0xFF);
+    uint32_t significand = bits & 0x007FFFFF;
+
+    if (biased_e == 0xFF) {
+        return special_to_str(buf, negative, significand != 0, false);
+    }
+
+    if (!biased_e && !significand) {
+        return special_to_str(buf, negative, false, true);
+    }
+
+    /* Use the boundaries of the float, so that the digits are the shortest
+     * that parse back to the same float, and not to the same double */
+    const uint64_t hidden_bit = 0x00800000;
+    diy_fp_t v;
+    if (biased_e) {
+        v = (diy_fp_t){significand + hidden_bit, biased_e - 150};
+    } else {
+        v = (diy_fp_t){significand, -149};
+    }
+
+    int32_t len = 0, k;
+    if (negative) {
+        buf[len ++] = '-';
+    }
+
+    int32_t digits = grisu2(v, hidden_bit, &buf[len], &k);
+    len += prettify(&buf[len], digits, k);
+    buf[len] = '\0';
+
+    return len;
+}
@@ -0,0 +1,28 @@
+#ifndef FLECS_META_NUMBER_H
+#define FLECS_META_NUMBER_H
+
+#include "flecs_meta.h"
+
+/* Minimum size of buffers passed to the number formatting functions */
+#define ECS_META_NUMBER_BUFFER_SIZE (32)
+
+/* Functions write a 0-terminated string to buf, and return its length */
+
+int32_t ecs_meta_u64_to_str(
+    char *buf,
+    uint64_t value);
+
+int32_t ecs_meta_i64_to_str(
+    char *buf,
+    int64_t value);
+
+/* Write shortest representation that parses back to the same value */
+int32_t ecs_meta_f64_to_str(
+    char *buf,
+    double value);
+
+int32_t ecs_meta_f32_to_str(
+    char *buf,
+    float value);
+
+#endif
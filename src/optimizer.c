@@ -0,0 +1,330 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "type.h"
+#include "world.h"
+
+bool ecs_meta_is_contiguous(
+    const EcsMetaTypeSerializer *ser)
+{
+    ecs_type_op_t *op = ecs_vector_first(ser->opt_ops, ecs_type_op_t);
+    return ecs_vector_count(ser->opt_ops) == 2 &&
+        op[1].kind == EcsOpBlit && op[1].offset == 0 &&
+        op[1].size == op[0].size;
+}
+
+/* Get serializer of the element type of a collection op. Returns NULL if the
+ * element type is pending, which happens when it has not been serialized yet
+ * or when the collection refers to the type that contains it. */
+static
+const EcsMetaTypeSerializer* elem_serializer(
+    ecs_world_t *world,
+    const EcsMetaTypeSerializer *ser,
+    ecs_type_op_ref_t *ref)
+{
+    const EcsMetaTypeSerializer *elem = ecs_meta_get_serializer(
+        world, ref->ref.entity);
+    if (!elem || !elem->ops || (ser && ref->ops == ser->ops)) {
+        return NULL;
+    }
+
+    return elem;
+}
+
+static
+bool is_float(
+    ecs_type_op_t *op)
+{
+    return op->kind == EcsOpPrimitive && 
+        (op->is.primitive == EcsF32 || op->is.primitive == EcsF64);
+}
+
+/* Returns whether the value of an op can be copied, compared and hashed as
+ * plain bytes, without following pointers. If split_floats is true, floating
+ * point numbers are not, as they must be compared by value. */
+static
+bool op_is_pod(
+    ecs_world_t *world,
+    ecs_type_op_t *op,
+    bool split_floats)
+{
+    switch(op->kind) {
+    case EcsOpPrimitive:
+        if (split_floats && is_float(op)) {
+            return false;
+        }
+        return op->is.primitive != EcsString;
+    case EcsOpEnum:
+    case EcsOpBitmask:
+    case EcsOpBlit:
+        return true;
+    case EcsOpArray: {
+        /* Elements with padding can be copied as bytes, but a blit would also
+         * compare and hash the uninitialized padding between elements */
+        const EcsMetaTypeSerializer *elem = elem_serializer(
+            world, NULL, &op->is.collection);
+        if (!elem || (split_floats && elem->has_floats)) {
+            return false;
+        }
+        return ecs_meta_is_contiguous(elem);
+    }
+    case EcsOpHeader:
+    case EcsOpPush:
+    case EcsOpPop:
+    case EcsOpVector:
+    case EcsOpMap:
+        return false;
+    }
+
+    return false;
+}
+
+/* Max depth is capped so that a cursor for any type fits in the scope array.
+ * Recursive types reach the cap, as their values can nest without limit. */
+#define MAX_DEPTH (ECS_META_MAX_SCOPE_DEPTH - 1)
+
+static
+void traits_add_element(
+    EcsMetaTypeSerializer *ser,
+    const EcsMetaTypeSerializer *elem,
+    int32_t depth)
+{
+    /* Assume the worst for pending elements. Traits are computed again when
+     * the element type is serialized. */
+    if (!elem) {
+        ser->is_pod = false;
+        ser->owns_heap = true;
+        ser->max_depth = MAX_DEPTH;
+        return;
+    }
+
+    ser->is_pod &= elem->is_pod;
+    ser->owns_heap |= elem->owns_heap;
+    ser->has_entities |= elem->has_entities;
+    ser->has_floats |= elem->has_floats;
+
+    /* Collections open a scope for their elements */
+    if ((depth + 1 + elem->max_depth) > ser->max_depth) {
+        ser->max_depth = depth + 1 + elem->max_depth;
+    }
+
+    if (ser->max_depth > MAX_DEPTH) {
+        ser->max_depth = MAX_DEPTH;
+    }
+}
+
+void ecs_meta_compute_traits(
+    ecs_world_t *world,
+    EcsMetaTypeSerializer *ser)
+{
+    ecs_type_op_t *op = ecs_vector_first(ser->ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ser->ops);
+    int32_t depth = 0;
+
+    ser->is_pod = true;
+    ser->owns_heap = false;
+    ser->has_entities = false;
+    ser->has_floats = false;
+    ser->max_depth = 0;
+
+    for (i = 0; i < count; i ++) {
+        switch(op[i].kind) {
+        case EcsOpHeader:
+        case EcsOpEnum:
+        case EcsOpBitmask:
+        case EcsOpBlit:
+            break;
+        case EcsOpPush:
+            depth ++;
+            if (depth > ser->max_depth) {
+                ser->max_depth = depth;
+            }
+            break;
+        case EcsOpPop:
+            depth --;
+            break;
+        case EcsOpPrimitive:
+            if (op[i].is.primitive == EcsString) {
+                ser->is_pod = false;
+                ser->owns_heap = true;
+            } else if (op[i].is.primitive == EcsEntity) {
+                ser->has_entities = true;
+            } else if (op[i].is.primitive == EcsF32 || 
+                op[i].is.primitive == EcsF64) 
+            {
+                ser->has_floats = true;
+            }
+            break;
+        case EcsOpArray:
+            traits_add_element(ser, elem_serializer(
+                world, ser, &op[i].is.collection), depth);
+            break;
+        case EcsOpVector:
+            ser->is_pod = false;
+            ser->owns_heap = true;
+            traits_add_element(ser, elem_serializer(
+                world, ser, &op[i].is.collection), depth);
+            break;
+        case EcsOpMap:
+            ser->is_pod = false;
+            ser->owns_heap = true;
+            traits_add_element(ser, elem_serializer(
+                world, ser, &op[i].is.map.key), depth);
+            traits_add_element(ser, elem_serializer(
+                world, ser, &op[i].is.map.element), depth);
+            break;
+        }
+    }
+}
+
+static
+ecs_vector_t* optimize_ops(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    bool split_floats)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ops);
+
+    ecs_assert(count != 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(op[0].kind == EcsOpHeader, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_vector_t *result = NULL;
+    ecs_type_op_t *dst = ecs_vector_add(&result, ecs_type_op_t);
+    *dst = op[0];
+
+    /* Member offsets are absolute, so push and pop ops carry no information
+     * that is needed for walking a flat value. Drop them, and merge adjacent
+     * members that can be copied as bytes into a single blit. Padding between
+     * members ends a run, so a blit never covers uninitialized memory. */
+    ecs_type_op_t *blit = NULL;
+
+    for (i = 1; i < count; i ++) {
+        ecs_type_op_t *src = &op[i];
+        if (src->kind == EcsOpPush || src->kind == EcsOpPop) {
+            continue;
+        }
+
+        if (!op_is_pod(world, src, split_floats)) {
+            dst = ecs_vector_add(&result, ecs_type_op_t);
+            *dst = *src;
+            blit = NULL;
+            continue;
+        }
+
+        ecs_size_t size = src->size * src->count;
+
+        if (blit && (blit->offset + blit->size) == src->offset) {
+            blit->size += size;
+        } else {
+            blit = ecs_vector_add(&result, ecs_type_op_t);
+            *blit = (ecs_type_op_t) {
+                .kind = EcsOpBlit,
+                .offset = src->offset,
+                .size = size,
+                .alignment = src->alignment,
+                .count = 1,
+                .name = src->name
+            };
+        }
+    }
+
+    return result;
+}
+
+ecs_vector_t* ecs_meta_optimize_ops(
+    ecs_world_t *world,
+    ecs_vector_t *ops)
+{
+    return optimize_ops(world, ops, false);
+}
+
+ecs_vector_t* ecs_meta_optimize_compare_ops(
+    ecs_world_t *world,
+    const EcsMetaTypeSerializer *ser)
+{
+    if (!ser->has_floats) {
+        return NULL;
+    }
+
+    return optimize_ops(world, ser->ops, true);
+}
+
+/* Entry of member index */
+typedef struct member_entry_t {
+    int32_t scope;       /* Index of first op of scope */
+    int32_t op;          /* Index of member op */
+} member_entry_t;
+
+static
+uint64_t member_key(
+    int32_t scope,
+    const char *name)
+{
+    return ecs_meta_hash_name(name, ecs_os_strlen(name)) ^ 
+        ((uint64_t)(uint32_t)scope * 0x9E3779B97F4A7C15ull);
+}
+
+ecs_map_t* ecs_meta_index_members(
+    ecs_vector_t *ops)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ops);
+    ecs_map_t *result = NULL;
+
+    /* Start of the scope of each nesting level. Ops after the header are in
+     * the scope that starts at 1, like the scope of a new cursor. */
+    int32_t scopes[ECS_META_MAX_SCOPE_DEPTH];
+    int32_t sp = 0;
+    scopes[0] = 1;
+
+    for (i = 1; i < count; i ++) {
+        if (op[i].name) {
+            if (!result) {
+                result = ecs_map_new(member_entry_t, count);
+            }
+
+            uint64_t key = member_key(scopes[sp], op[i].name);
+            if (ecs_map_get(result, member_entry_t, key)) {
+                /* Same key for two members, use linear search instead */
+                ecs_map_free(result);
+                return NULL;
+            }
+
+            member_entry_t entry = { .scope = scopes[sp], .op = i };
+            ecs_map_set(result, key, &entry);
+        }
+
+        if (op[i].kind == EcsOpPush) {
+            sp ++;
+            ecs_assert(sp < ECS_META_MAX_SCOPE_DEPTH, 
+                ECS_INVALID_PARAMETER, NULL);
+            scopes[sp] = i + 1;
+        } else if (op[i].kind == EcsOpPop) {
+            ecs_assert(sp > 0, ECS_INTERNAL_ERROR, NULL);
+            sp --;
+        }
+    }
+
+    return result;
+}
+
+int32_t ecs_meta_find_member(
+    ecs_map_t *members,
+    ecs_vector_t *ops,
+    int32_t scope,
+    const char *name)
+{
+    member_entry_t *entry = ecs_map_get(
+        members, member_entry_t, member_key(scope, name));
+    if (!entry || entry->scope != scope) {
+        return -1;
+    }
+
+    /* Key may be the same as the key of a member with a different name */
+    ecs_type_op_t *op = ecs_vector_get(ops, ecs_type_op_t, entry->op);
+    if (strcmp(op->name, name)) {
+        return -1;
+    }
+
+    return entry->op;
+}
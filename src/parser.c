@@ -74,28 +74,31 @@ const char* parse_digit(
 static
 const char* parse_identifier(
     const char *ptr, 
-    char *buff,
-    char *params,
+    ecs_meta_token_t *token,
+    ecs_meta_token_t *params,
     ecs_meta_parse_ctx_t *ctx) 
 {
     ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(buff != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(token != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(ctx != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    char *bptr = buff, ch;
+    char ch;
 
     if (params) {
-        params[0] = '\0';
+        params->ptr = NULL;
+        params->len = 0;
     }
 
     /* Ignore whitespaces */
     ptr = skip_ws(ptr);
 
-    if (!isalpha(*ptr)) {
+    if (!isalpha((unsigned char)*ptr) && *ptr != '_') {
         ecs_meta_error(ctx, ptr, 
             "invalid identifier (starts with '%c')", *ptr);
     }
 
+    token->ptr = ptr;
+
     while ((ch = *ptr) && !isspace(ch) && ch != ';' && ch != ',' && ch != ')' && ch != '>') {
         /* Type definitions can contain macro's or templates */
         if (ch == '(' || ch == '<') {
@@ -103,19 +106,23 @@ const char* parse_identifier(
                 ecs_meta_error(ctx, ptr, "unexpected %c", *ptr);
             }
 
+            token->len = (ecs_size_t)(ptr - token->ptr);
+
             const char *end = skip_scope(ptr, ctx);
-            ecs_os_strncpy(params, ptr, (ecs_size_t)(end - ptr));
-            params[end - ptr] = '\0';
+            params->ptr = ptr;
+            params->len = (ecs_size_t)(end - ptr);
 
             ptr = end;
-        } else {
-            *bptr = ch;
-            bptr ++;
-            ptr ++;
+            ch = *ptr;
+            break;
         }
+
+        ptr ++;
     }
 
-    *bptr = '\0';
+    if (!params || !params->ptr) {
+        token->len = (ecs_size_t)(ptr - token->ptr);
+    }
 
     if (!ch) {
         ecs_meta_error(ctx, ptr, "unexpected end of token");
@@ -124,6 +131,22 @@ const char* parse_identifier(
     return ptr;
 }
 
+bool ecs_meta_token_eq(
+    const ecs_meta_token_t *token,
+    const char *str)
+{
+    return !strncmp(token->ptr, str, (size_t)token->len) && !str[token->len];
+}
+
+char* ecs_meta_token_dup(
+    const ecs_meta_token_t *token)
+{
+    char *result = ecs_os_malloc(token->len + 1);
+    ecs_os_memcpy(result, token->ptr, token->len);
+    result[token->len] = '\0';
+    return result;
+}
+
 static
 const char * ecs_meta_open_scope(
     const char *ptr,
@@ -173,7 +196,7 @@ const char* ecs_meta_parse_constant(
     token->is_value_set = false;
 
     /* Parse token, constant identifier */
-    ptr = parse_identifier(ptr, token->name, NULL, ctx);
+    ptr = parse_identifier(ptr, &token->name, NULL, ctx);
     ptr = skip_ws(ptr);
 
     /* Explicit value assignment */
@@ -208,19 +231,19 @@ const char* ecs_meta_parse_type(
     ptr = skip_ws(ptr);
 
     /* Parse token, expect type identifier or ECS_PROPERTY */
-    ptr = parse_identifier(ptr, token->type, token->params, ctx);
+    ptr = parse_identifier(ptr, &token->type, &token->params, ctx);
 
-    if (!strcmp(token->type, "ECS_PRIVATE")) {
+    if (ecs_meta_token_eq(&token->type, "ECS_PRIVATE")) {
         /* Members from this point are not stored in metadata */
         return NULL;
     }
 
     /* If token is const, set const flag and continue parsing type */
-    if (!strcmp(token->type, "const")) {
+    if (ecs_meta_token_eq(&token->type, "const")) {
         token->is_const = true;
 
         /* Parse type after const */
-        ptr = parse_identifier(ptr + 1, token->type, token->params, ctx);
+        ptr = parse_identifier(ptr + 1, &token->type, &token->params, ctx);
     }
 
     /* Check if type is a pointer */
@@ -255,28 +278,29 @@ const char* ecs_meta_parse_member(
     }
 
     /* Next token is the identifier */
-    ptr = parse_identifier(ptr, token->name, NULL, ctx);
+    ptr = parse_identifier(ptr, &token->name, NULL, ctx);
 
     /* Skip whitespace between member and [ or ; */
     ptr = skip_ws(ptr);
 
     /* Check if this is an array */
-    char *array_start = strchr(token->name, '[');
+    const char *array_start = memchr(
+        token->name.ptr, '[', (size_t)token->name.len);
     if (!array_start) {
         /* If the [ was separated by a space, it will not be parsed as part of
          * the name */
         if (*ptr == '[') {
-            array_start = (char*)ptr; /* safe, will not be modified */
+            array_start = ptr;
         }
     }
 
     if (array_start) {
         /* Check if the [ matches with a ] */
-        char *array_end = strchr(array_start, ']');
+        const char *array_end = strchr(array_start, ']');
         if (!array_end) {
             ecs_meta_error(ctx, ptr, "missing ']'");
 
-        } else if (array_end - array_start == 0) {
+        } else if (skip_ws(array_start + 1) == array_end) {
             ecs_meta_error(ctx, ptr, "dynamic size arrays are not supported");
         }
 
@@ -286,8 +310,8 @@ const char* ecs_meta_parse_member(
             /* If [ was found after name, continue parsing after ] */
             ptr = array_end + 1;
         } else {
-            /* If [ was fonud in name, replace it with 0 terminator */
-            array_start[0] = '\0';
+            /* If [ was found in name, remove it from the name */
+            token->name.len = (ecs_size_t)(array_start - token->name.ptr);
         }
     }
 
@@ -3,12 +3,18 @@
 
 #include "flecs_meta.h"
 
+/* Size of buffer used to terminate identifiers for lookups. Longer identifiers
+ * are copied to the heap. */
 #define ECS_META_IDENTIFIER_LENGTH (256)
 
 #define ecs_meta_error(ctx, ptr, ...)\
     ecs_parser_error((ctx)->name, (ctx)->decl, ptr - (ctx)->decl, __VA_ARGS__)
 
-typedef char ecs_meta_token_t[ECS_META_IDENTIFIER_LENGTH];
+/* Tokens are views into the type descriptor, and are not 0-terminated */
+typedef struct ecs_meta_token_t {
+    const char *ptr;
+    ecs_size_t len;
+} ecs_meta_token_t;
 
 typedef struct ecs_meta_parse_ctx_t {
     const char *name;
@@ -43,6 +49,15 @@ typedef struct ecs_meta_params_t {
     bool is_fixed_size;
 } ecs_meta_params_t;
 
+/* Test if token is equal to string */
+bool ecs_meta_token_eq(
+    const ecs_meta_token_t *token,
+    const char *str);
+
+/* Create 0-terminated copy of token */
+char* ecs_meta_token_dup(
+    const ecs_meta_token_t *token);
+
 const char* ecs_meta_parse_constant(
     const char *ptr,
     ecs_meta_constant_t *token_out,
@@ -1,4 +1,9 @@
 #include <flecs_meta.h>
+#include "number.h"
+#include "serializer.h"
+#include "sink.h"
+#include "type.h"
+#include "world.h"
 
 /* Simple serializer to turn values into strings. Use this code as a template
  * for when implementing a new serializer. */
@@ -8,14 +13,48 @@ int str_ser_type(
     ecs_world_t *world,
     ecs_vector_t *ser, 
     const void *base, 
-    ecs_strbuf_t *str);
+    ecs_meta_sink_t *str);
 
 static
 int str_ser_type_op(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base,
-    ecs_strbuf_t *str);
+    ecs_meta_sink_t *str);
+
+/* Direct mapped cache for names of entity values. The cache has a fixed size,
+ * so that serializing a large world does not require memory proportional to
+ * the number of referenced entities. */
+#define STR_NAME_CACHE_BITS (10)
+#define STR_NAME_CACHE_SIZE (1 << STR_NAME_CACHE_BITS)
+
+typedef struct ecs_meta_name_cache_t {
+    ecs_entity_t entities[STR_NAME_CACHE_SIZE];
+    const char *names[STR_NAME_CACHE_SIZE];
+} ecs_meta_name_cache_t;
+
+static
+const char* str_get_name(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_meta_sink_t *str)
+{
+    ecs_meta_name_cache_t *cache = str->name_cache;
+    if (!cache || !entity) {
+        return ecs_get_name(world, entity);
+    }
+
+    /* Fibonacci hashing, so that sequential ids are spread over the cache */
+    uint64_t index = (entity * 0x9E3779B97F4A7C15ull) >> 
+        (64 - STR_NAME_CACHE_BITS);
+
+    if (cache->entities[index] != entity) {
+        cache->entities[index] = entity;
+        cache->names[index] = ecs_get_name(world, entity);
+    }
+
+    return cache->names[index];
+}
 
 /* Serialize a primitive value */
 static
@@ -23,94 +62,111 @@ void str_ser_primitive(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     const char *bool_str[] = { "false", "true" };
+    char numbuf[ECS_META_NUMBER_BUFFER_SIZE];
+    int32_t len = 0;
 
     switch(op->is.primitive) {
     case EcsBool:
-        ecs_strbuf_appendstr(str, bool_str[(int)*(bool*)base]);
+        ecs_meta_sink_appendstr(str, bool_str[(int)*(bool*)base]);
         break;
     case EcsChar: {
         char chbuf[3];
         ecs_chresc(chbuf, *(char*)base, '\'');
 
-        ecs_strbuf_appendstrn(str, "'", 1);
-        ecs_strbuf_appendstr(str, chbuf);
-        ecs_strbuf_appendstrn(str, "'", 1);
+        ecs_meta_sink_appendstrn(str, "'", 1);
+        ecs_meta_sink_appendstr(str, chbuf);
+        ecs_meta_sink_appendstrn(str, "'", 1);
         break;
     }
-    case EcsByte:
-        ecs_strbuf_append(str, "0x%x", *(uint8_t*)base);
+    case EcsByte: {
+        const char *hex = "0123456789abcdef";
+        uint8_t value = *(uint8_t*)base;
+        numbuf[0] = '0';
+        numbuf[1] = 'x';
+        len = 2;
+        if (value >= 16) {
+            numbuf[len ++] = hex[value >> 4];
+        }
+        numbuf[len ++] = hex[value & 15];
         break;
+    }
     case EcsU8:
-        ecs_strbuf_append(str, "%u", *(uint8_t*)base);
+        len = ecs_meta_u64_to_str(numbuf, *(uint8_t*)base);
         break;
     case EcsU16:
-        ecs_strbuf_append(str, "%u", *(uint16_t*)base);
+        len = ecs_meta_u64_to_str(numbuf, *(uint16_t*)base);
         break;
     case EcsU32:
-        ecs_strbuf_append(str, "%u", *(uint32_t*)base);
+        len = ecs_meta_u64_to_str(numbuf, *(uint32_t*)base);
         break;
     case EcsU64:
-        ecs_strbuf_append(str, "%llu", *(uint64_t*)base);
+        len = ecs_meta_u64_to_str(numbuf, *(uint64_t*)base);
         break;
     case EcsI8:
-        ecs_strbuf_append(str, "%d", *(int8_t*)base);
+        len = ecs_meta_i64_to_str(numbuf, *(int8_t*)base);
         break;
     case EcsI16:
-        ecs_strbuf_append(str, "%d", *(int16_t*)base);
+        len = ecs_meta_i64_to_str(numbuf, *(int16_t*)base);
         break;
     case EcsI32:
-        ecs_strbuf_append(str, "%d", *(int32_t*)base);
+        len = ecs_meta_i64_to_str(numbuf, *(int32_t*)base);
         break;
     case EcsI64:
-        ecs_strbuf_append(str, "%lld", *(int64_t*)base);
+        len = ecs_meta_i64_to_str(numbuf, *(int64_t*)base);
         break;
     case EcsF32:
-        ecs_strbuf_append(str, "%f", *(float*)base);
+        len = ecs_meta_f32_to_str(numbuf, *(float*)base);
         break;
     case EcsF64:
-        ecs_strbuf_append(str, "%f", *(double*)base);
+        len = ecs_meta_f64_to_str(numbuf, *(double*)base);
         break;
     case EcsIPtr:
-        ecs_strbuf_append(str, "%i", *(intptr_t*)base);
+        len = ecs_meta_i64_to_str(numbuf, *(intptr_t*)base);
         break;
     case EcsUPtr:
-        ecs_strbuf_append(str, "%u", *(uintptr_t*)base);
+        len = ecs_meta_u64_to_str(numbuf, *(uintptr_t*)base);
         break;
     case EcsString: {
         char *value = *(char**)base;
         if (value) {
-            ecs_size_t length = ecs_stresc(NULL, 0, '"', value);
-            if (length == ecs_os_strlen(value)) {
-                ecs_strbuf_appendstrn(str, "\"", 1);
-                ecs_strbuf_appendstr(str, value);
-                ecs_strbuf_appendstrn(str, "\"", 1);
-            } else {
-                char *out = ecs_os_malloc(length + 3);
-                ecs_stresc(out + 1, length, '"', value);
-                out[0] = '"';
-                out[length + 1] = '"';
-                out[length + 2] = '\0';
-                ecs_strbuf_appendstr_zerocpy(str, out);
+            /* Write runs of characters that don't need escaping directly */
+            const char *run = value, *ptr;
+            ecs_meta_sink_appendstrn(str, "\"", 1);
+            for (ptr = value; *ptr; ptr ++) {
+                char chbuf[3];
+                char *end = ecs_chresc(chbuf, *ptr, '"');
+                ecs_size_t esc_len = (ecs_size_t)(end - chbuf);
+                if (esc_len != 1) {
+                    ecs_meta_sink_appendstrn(str, run, (ecs_size_t)(ptr - run));
+                    ecs_meta_sink_appendstrn(str, chbuf, esc_len);
+                    run = ptr + 1;
+                }
             }
+            ecs_meta_sink_appendstrn(str, run, (ecs_size_t)(ptr - run));
+            ecs_meta_sink_appendstrn(str, "\"", 1);
         } else {
-            ecs_strbuf_appendstr(str, "nullptr");
+            ecs_meta_sink_appendstr(str, "nullptr");
         }
         break;
     }
     case EcsEntity: {
         ecs_entity_t e = *(ecs_entity_t*)base;
-        const char *name = ecs_get_name(world, e);
+        const char *name = str_get_name(world, e, str);
         if (name) {
-            ecs_strbuf_appendstr(str, name);
+            ecs_meta_sink_appendstr(str, name);
         } else {
-            ecs_strbuf_append(str, "%u", e);
+            len = ecs_meta_u64_to_str(numbuf, e);
         }
         break;
     }
     }
+
+    if (len) {
+        ecs_meta_sink_appendstrn(str, numbuf, len);
+    }
 }
 
 /* Serialize enumeration */
@@ -119,58 +175,90 @@ int str_ser_enum(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     const EcsEnum *enum_type = ecs_get_ref_w_entity(world, &op->is.constant, 0, 0);
     ecs_assert(enum_type != NULL, ECS_INVALID_PARAMETER, NULL);
 
     int32_t value = *(int32_t*)base;
     
-    /* Enumeration constants are stored in a map that is keyed on the
-     * enumeration value. */
-    char **constant = ecs_map_get(enum_type->constants, char*, value);
+    const char *constant = ecs_meta_enum_name(enum_type, value);
     if (!constant) {
         return -1;
     }
 
-    ecs_strbuf_appendstr(str, *constant);
+    ecs_meta_sink_appendstr(str, constant);
 
     return 0;
 }
 
+/* Index of lowest set bit. Value must not be 0. */
+static
+int32_t ctz32(
+    uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int32_t result = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        result ++;
+    }
+    return result;
+#endif
+}
+
 /* Serialize bitmask */
 static
 int str_ser_bitmask(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     const EcsBitmask *bitmask_type = ecs_get_ref_w_entity(world, &op->is.constant, 0, 0);
     ecs_assert(bitmask_type != NULL, ECS_INVALID_PARAMETER, NULL);
 
     uint32_t value = *(uint32_t*)base;
-    ecs_map_key_t key;
-    char **constant;
     int count = 0;
 
-    ecs_strbuf_list_push(str, "", " | ");
+    ecs_meta_sink_list_push(str, "", " | ");
 
-    /* Multiple flags can be set at a given time. Iterate through all the flags
-     * and append the ones that are set. */
-    ecs_map_iter_t it = ecs_map_iter(bitmask_type->constants);
-    while ((constant = ecs_map_next(&it, char*, &key))) {
-        if ((value & key) == key) {
-            ecs_strbuf_list_appendstr(str, *constant);
+    if (!value) {
+        char **constant = ecs_map_get(bitmask_type->constants, char*, 0);
+        ecs_meta_sink_list_appendstr(str, constant ? *constant : "0");
+        ecs_meta_sink_list_pop(str, "");
+        return 0;
+    }
+
+    /* Constants with multiple bits are matched first, so that their bits are
+     * not also added as individual flags */
+    ecs_vector_each(bitmask_type->compounds, ecs_meta_bitmask_constant_t, c, {
+        if ((value & c->value) == c->value) {
+            ecs_meta_sink_list_appendstr(str, c->name);
+            value &= ~c->value;
             count ++;
         }
+    });
+
+    /* Walk the remaining bits. Bits without a constant are not added. */
+    char **bits = ecs_vector_first(bitmask_type->bits, char*);
+    if (bits) {
+        for (; value; value &= value - 1) {
+            const char *name = bits[ctz32(value)];
+            if (name) {
+                ecs_meta_sink_list_appendstr(str, name);
+                count ++;
+            }
+        }
     }
 
     if (!count) {
-        ecs_strbuf_list_appendstr(str, "0");
+        ecs_meta_sink_list_appendstr(str, "0");
     }
 
-    ecs_strbuf_list_pop(str, "");
+    ecs_meta_sink_list_pop(str, "");
 
     return 0;
 }
@@ -183,22 +271,22 @@ int str_ser_elements(
     const void *base, 
     int32_t elem_count, 
     int32_t elem_size,
-    ecs_strbuf_t *str)
+    ecs_meta_sink_t *str)
 {
-    ecs_strbuf_list_push(str, "[", ", ");
+    ecs_meta_sink_list_push(str, "[", ", ");
 
     const void *ptr = base;
 
     int i;
     for (i = 0; i < elem_count; i ++) {
-        ecs_strbuf_list_next(str);
+        ecs_meta_sink_list_next(str);
         if (str_ser_type(world, elem_ops, ptr, str)) {
             return -1;
         }
         ptr = ECS_OFFSET(ptr, elem_size);
     }
 
-    ecs_strbuf_list_pop(str, "]");
+    ecs_meta_sink_list_pop(str, "]");
 
     return 0;
 }
@@ -209,13 +297,13 @@ int str_ser_array(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
-    const EcsMetaTypeSerializer *ser = ecs_get_ref_w_entity(world, &op->is.collection, 0, 0);
-    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_vector_t *elem_ops = ecs_type_op_ref_get(world, &op->is.collection);
+    ecs_assert(elem_ops != NULL, ECS_INTERNAL_ERROR, NULL);
 
     return str_ser_elements(
-        world, ser->ops, base, op->count, op->size, str);
+        world, elem_ops, base, op->count, op->size, str);
 }
 
 /* Serialize vector */
@@ -224,20 +312,19 @@ int str_ser_vector(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     ecs_vector_t *value = *(ecs_vector_t**)base;
     if (!value) {
-        ecs_strbuf_appendstr(str, "nullptr");
+        ecs_meta_sink_appendstr(str, "nullptr");
         return 0;
     }
     
-    const EcsMetaTypeSerializer *ser = ecs_get_ref_w_entity(world, &op->is.collection, 0, 0);
-    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_vector_t *elem_ops = ecs_type_op_ref_get(world, &op->is.collection);
+    ecs_assert(elem_ops != NULL, ECS_INTERNAL_ERROR, NULL);
 
     int32_t count = ecs_vector_count(value);
     void *array = ecs_vector_first_t(value, op->size, op->alignment);
-    ecs_vector_t *elem_ops = ser->ops;
     
     ecs_type_op_t *elem_op_hdr = (ecs_type_op_t*)ecs_vector_first(elem_ops, ecs_type_op_t);
     ecs_assert(elem_op_hdr != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -254,20 +341,20 @@ int str_ser_map(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     ecs_map_t *value = *(ecs_map_t**)base;
 
-    const EcsMetaTypeSerializer *key_ser = ecs_get_ref_w_entity(world, &op->is.map.key, 0, 0);
-    ecs_assert(key_ser != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_vector_t *key_ops = ecs_type_op_ref_get(world, &op->is.map.key);
+    ecs_assert(key_ops != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    const EcsMetaTypeSerializer *elem_ser = ecs_get_ref_w_entity(world, &op->is.map.element, 0, 0);
-    ecs_assert(elem_ser != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_vector_t *elem_ops = ecs_type_op_ref_get(world, &op->is.map.element);
+    ecs_assert(elem_ops != NULL, ECS_INTERNAL_ERROR, NULL);
 
     /* 2 instructions, one for the header */
-    ecs_assert(ecs_vector_count(key_ser->ops) == 2, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(ecs_vector_count(key_ops) == 2, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_type_op_t *key_op = ecs_vector_first(key_ser->ops, ecs_type_op_t);
+    ecs_type_op_t *key_op = ecs_vector_first(key_ops, ecs_type_op_t);
     ecs_assert(key_op->kind == EcsOpHeader, ECS_INTERNAL_ERROR, NULL);
     key_op = &key_op[1];
 
@@ -275,24 +362,24 @@ int str_ser_map(
     ecs_map_key_t key; 
     void *ptr;
 
-    ecs_strbuf_list_push(str, "{", ", ");
+    ecs_meta_sink_list_push(str, "{", ", ");
 
     while ((ptr = _ecs_map_next(&it, 0, &key))) {
-        ecs_strbuf_list_next(str);
+        ecs_meta_sink_list_next(str);
         if (str_ser_type_op(world, key_op, (void*)&key, str)) {
             return -1;
         }
 
-        ecs_strbuf_appendstr(str, " = ");
+        ecs_meta_sink_appendstr(str, " = ");
         
-        if (str_ser_type(world, elem_ser->ops, ptr, str)) {
+        if (str_ser_type(world, elem_ops, ptr, str)) {
             return -1;
         }
 
         key = 0;
     }
 
-    ecs_strbuf_list_pop(str, "}");
+    ecs_meta_sink_list_pop(str, "}");
 
     return 0;
 }
@@ -303,12 +390,13 @@ int str_ser_type_op(
     ecs_world_t *world,
     ecs_type_op_t *op, 
     const void *base,
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     switch(op->kind) {
     case EcsOpHeader:
     case EcsOpPush:
     case EcsOpPop:
+    case EcsOpBlit:
         /* Should not be parsed as single op */
         ecs_abort(ECS_INVALID_PARAMETER, NULL);
         break;
@@ -351,7 +439,7 @@ int str_ser_type(
     ecs_world_t *world,
     ecs_vector_t *ser, 
     const void *base, 
-    ecs_strbuf_t *str) 
+    ecs_meta_sink_t *str) 
 {
     ecs_type_op_t *ops = (ecs_type_op_t*)ecs_vector_first(ser, ecs_type_op_t);
     int32_t count = ecs_vector_count(ser);
@@ -362,20 +450,21 @@ int str_ser_type(
         if (op->name) {
             if (op->kind != EcsOpHeader)
             {
-                ecs_strbuf_list_next(str);
+                ecs_meta_sink_list_next(str);
             }
 
-            ecs_strbuf_append(str, "%s = ", op->name);
+            ecs_meta_sink_appendstr(str, op->name);
+            ecs_meta_sink_appendstrn(str, " = ", 3);
         }
 
         switch(op->kind) {
         case EcsOpHeader:
             break;
         case EcsOpPush:
-            ecs_strbuf_list_push(str, "{", ", ");
+            ecs_meta_sink_list_push(str, "{", ", ");
             break;
         case EcsOpPop:
-            ecs_strbuf_list_pop(str, "}");
+            ecs_meta_sink_list_pop(str, "}");
             break;
         default:
             if (str_ser_type_op(world, op, base, str)) {
@@ -387,64 +476,357 @@ int str_ser_type(
 
     return 0;
 error:
-    ecs_strbuf_reset(str);
+    ecs_meta_sink_reset(str);
     return -1;
 }
 
+/* Write action that appends to a string buffer */
+static
+int strbuf_write(
+    void *ctx,
+    const char *str,
+    ecs_size_t len)
+{
+    ecs_strbuf_appendstrn(ctx, str, len);
+    return 0;
+}
+
+int ecs_ptr_to_sink(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    ecs_meta_sink_t *sink)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
+    ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (str_ser_type(world, ser->ops, ptr, sink)) {
+        ecs_meta_sink_flush(sink);
+        return -1;
+    }
+
+    return ecs_meta_sink_flush(sink);
+}
+
+ecs_size_t ecs_ptr_to_str_buf(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    char *buf,
+    ecs_size_t len)
+{
+    ecs_meta_sink_t sink = ecs_meta_sink_buf(buf, len);
+    if (ecs_ptr_to_sink(world, type, ptr, &sink)) {
+        return -1;
+    }
+
+    return sink.written;
+}
+
 char* ecs_ptr_to_str(
     ecs_world_t *world, 
     ecs_entity_t type, 
     void* ptr)
 {
-    ecs_entity_t ecs_entity(EcsMetaTypeSerializer) = ecs_lookup_fullpath(world, "flecs.meta.MetaTypeSerializer");
-    const EcsMetaTypeSerializer *ser = ecs_get(world, type, EcsMetaTypeSerializer);
+    ecs_strbuf_t str = ECS_STRBUF_INIT;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(strbuf_write, &str, NULL, 0);
+
+    if (ecs_ptr_to_sink(world, type, ptr, &sink)) {
+        ecs_strbuf_reset(&str);
+        return NULL;
+    }
+
+    return ecs_strbuf_get(&str);
+}
+
+char* ecs_array_to_str(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *ptr,
+    int32_t count)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
     ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
 
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+    ecs_size_t size = ops[0].size;
+
     ecs_strbuf_t str = ECS_STRBUF_INIT;
-    if (str_ser_type(world, ser->ops, ptr, &str)) {
-        return NULL;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(strbuf_write, &str, NULL, 0);
+    ecs_meta_sink_list_push(&sink, "[", ", ");
+
+    int i;
+    if (ecs_vector_count(ser->ops) == 2 && ops[1].kind == EcsOpPrimitive) {
+        /* Type is a single primitive, skip iterating the ops per element */
+        for (i = 0; i < count; i ++) {
+            ecs_meta_sink_list_next(&sink);
+            str_ser_primitive(world, &ops[1], ECS_OFFSET(ptr, i * size), &sink);
+        }
+    } else {
+        for (i = 0; i < count; i ++) {
+            ecs_meta_sink_list_next(&sink);
+            if (str_ser_type(world, ser->ops, ECS_OFFSET(ptr, i * size), &sink)) {
+                ecs_strbuf_reset(&str);
+                return NULL;
+            }
+        }
     }
 
+    ecs_meta_sink_list_pop(&sink, "]");
+
     return ecs_strbuf_get(&str);
 }
 
-char* ecs_entity_to_str(
-    ecs_world_t *world, 
-    ecs_entity_t entity)
+/* Number of component columns that are resolved without allocating */
+#define STR_MAX_STACK_COLUMNS (32)
+
+/* Component column of an entity or table that has a serializer */
+typedef struct str_column_t {
+    ecs_entity_t component;
+    const char *name;
+    ecs_vector_t *ops;
+    const void *ptr;
+    ecs_size_t size;
+} str_column_t;
+
+static
+int str_ser_entity(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    str_column_t *columns,
+    int32_t count,
+    int32_t row,
+    ecs_meta_sink_t *str)
+{
+    const char *name = ecs_get_name(world, entity);
+    if (name) {
+        ecs_meta_sink_appendstr(str, name);
+        ecs_meta_sink_appendstrn(str, ": ", 2);
+    }
+
+    ecs_meta_sink_appendstrn(str, "{\n", 2);
+
+    int i;
+    for (i = 0; i < count; i ++) {
+        ecs_meta_sink_appendstrn(str, "    ", 4);
+        ecs_meta_sink_appendstr(str, columns[i].name);
+        ecs_meta_sink_appendstrn(str, ": ", 2);
+
+        if (str_ser_type(world, columns[i].ops, 
+            ECS_OFFSET(columns[i].ptr, row * columns[i].size), str)) 
+        {
+            return -1;
+        }
+
+        ecs_meta_sink_appendstrn(str, "\n", 1);
+    }
+
+    ecs_meta_sink_appendstrn(str, "}", 1);
+
+    return 0;
+}
+
+int ecs_entity_to_sink(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_meta_sink_t *sink)
 {
     ecs_type_t type = ecs_get_type(world, entity);
     ecs_entity_t *ids = (ecs_entity_t*)ecs_vector_first(type, ecs_entity_t);
     int32_t count = ecs_vector_count(type);
+
+    str_column_t stack_columns[STR_MAX_STACK_COLUMNS];
+    str_column_t *columns = stack_columns;
+    if (count > STR_MAX_STACK_COLUMNS) {
+        columns = ecs_os_malloc(ECS_SIZEOF(str_column_t) * count);
+    }
+
+    int i, column_count = 0;
+    for (i = 0; i < count; i ++) {
+        const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(
+            world, ids[i]);
+        if (ser) {
+            columns[column_count ++] = (str_column_t){
+                .component = ids[i],
+                .name = ecs_get_name(world, ids[i]),
+                .ops = ser->ops,
+                .ptr = ecs_get_w_entity(world, entity, ids[i])
+            };
+        }
+    }
+
+    int result = str_ser_entity(world, entity, columns, column_count, 0, sink);
     
-    ecs_entity_t ecs_entity(EcsMetaTypeSerializer) = ecs_lookup_fullpath(world, "flecs.meta.MetaTypeSerializer");
+    if (columns != stack_columns) {
+        ecs_os_free(columns);
+    }
+
+    if (ecs_meta_sink_flush(sink)) {
+        result = -1;
+    }
+
+    return result;
+}
+
+char* ecs_entity_to_str(
+    ecs_world_t *world, 
+    ecs_entity_t entity)
+{
     ecs_strbuf_t str = ECS_STRBUF_INIT;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(strbuf_write, &str, NULL, 0);
 
-    const char *name = ecs_get_name(world, entity);
-    if (name) {
-        ecs_strbuf_append(&str, "%s: ", name);
+    if (ecs_entity_to_sink(world, entity, &sink)) {
+        ecs_strbuf_reset(&str);
+        return NULL;
     }
 
-    ecs_strbuf_appendstr(&str, "{\n");
+    return ecs_strbuf_get(&str);
+}
+
+/* Resolve serializers and column pointers of the table of an iterator. The
+ * columns array must have space for all columns of the table. */
+static
+int32_t str_resolve_columns(
+    ecs_world_t *world,
+    ecs_iter_t *it,
+    str_column_t *columns)
+{
+    ecs_type_t type = ecs_iter_type(it);
+    ecs_entity_t *ids = (ecs_entity_t*)ecs_vector_first(type, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(type), column_count = 0;
 
-    int i, comps_serialized = 0;
     for (i = 0; i < count; i ++) {
-        const EcsMetaTypeSerializer *ser = ecs_get(world, ids[i], EcsMetaTypeSerializer);
-        if (ser) {
-            const void *ptr = ecs_get_w_entity(world, entity, ids[i]);
-            ecs_strbuf_append(&str, "    %s: ", ecs_get_name(world, ids[i]));
-            if (str_ser_type(world, ser->ops, ptr, &str)) {
-                goto error;
-            }
+        const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(
+            world, ids[i]);
+        if (!ser) {
+            continue;
+        }
 
-            ecs_strbuf_appendstr(&str, "\n");
-            comps_serialized ++;
+        void *ptr = ecs_table_column(it, i);
+        if (!ptr) {
+            continue;
         }
+
+        columns[column_count ++] = (str_column_t){
+            .component = ids[i],
+            .name = ecs_get_name(world, ids[i]),
+            .ops = ser->ops,
+            .ptr = ptr,
+            .size = (ecs_size_t)ecs_table_column_size(it, i)
+        };
     }
 
-    ecs_strbuf_appendstr(&str, "}");
+    return column_count;
+}
 
-    return ecs_strbuf_get(&str);  
-error:
-    ecs_strbuf_reset(&str);
-    return NULL;
+/* Serialize the entities of an iterator. Entities are separated by newlines,
+ * also from entities of previous tables when first is false. */
+static
+int str_ser_iter(
+    ecs_world_t *world,
+    ecs_iter_t *it,
+    str_column_t *columns,
+    int32_t column_count,
+    bool first,
+    ecs_meta_sink_t *str)
+{
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        if (i || !first) {
+            ecs_meta_sink_appendstrn(str, "\n", 1);
+        }
+
+        if (str_ser_entity(
+            world, it->entities[i], columns, column_count, i, str)) 
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+char* ecs_iter_to_str(
+    ecs_iter_t *it)
+{
+    ecs_world_t *world = it->world;
+    int32_t count = ecs_vector_count(ecs_iter_type(it));
+
+    ecs_strbuf_t str = ECS_STRBUF_INIT;
+    ecs_meta_sink_t sink = ecs_meta_sink_action(strbuf_write, &str, NULL, 0);
+
+    /* Resolve serializers and column pointers once for all entities */
+    str_column_t stack_columns[STR_MAX_STACK_COLUMNS];
+    str_column_t *columns = stack_columns;
+    if (count > STR_MAX_STACK_COLUMNS) {
+        columns = ecs_os_malloc(ECS_SIZEOF(str_column_t) * count);
+    }
+
+    int32_t column_count = str_resolve_columns(world, it, columns);
+    int result = str_ser_iter(world, it, columns, column_count, true, &sink);
+
+    if (columns != stack_columns) {
+        ecs_os_free(columns);
+    }
+
+    if (result) {
+        ecs_strbuf_reset(&str);
+        return NULL;
+    }
+
+    return ecs_strbuf_get(&str);
+}
+
+int ecs_world_to_str_stream(
+    ecs_world_t *world,
+    ecs_meta_sink_t *sink)
+{
+    ecs_meta_name_cache_t *cache = ecs_os_calloc(
+        ECS_SIZEOF(ecs_meta_name_cache_t));
+    sink->name_cache = cache;
+
+    /* Column buffer is reused for all tables */
+    str_column_t *columns = NULL;
+    int32_t columns_size = 0;
+    bool first = true;
+    int result = 0;
+
+    ecs_filter_t filter = { 0 };
+    ecs_iter_t it = ecs_filter_iter(world, &filter);
+
+    while (ecs_filter_next(&it)) {
+        int32_t count = ecs_vector_count(ecs_iter_type(&it));
+        if (count > columns_size) {
+            columns_size = count;
+            columns = ecs_os_realloc(columns, 
+                ECS_SIZEOF(str_column_t) * columns_size);
+        }
+
+        int32_t column_count = str_resolve_columns(world, &it, columns);
+        if (!column_count || !it.count) {
+            continue;
+        }
+
+        if (str_ser_iter(world, &it, columns, column_count, first, sink)) {
+            result = -1;
+            break;
+        }
+
+        /* Stop early if the write action failed */
+        if (sink->failed) {
+            break;
+        }
+
+        first = false;
+    }
+
+    ecs_os_free(columns);
+    ecs_os_free(cache);
+    sink->name_cache = NULL;
+
+    if (ecs_meta_sink_flush(sink)) {
+        result = -1;
+    }
+
+    return result;
 }
@@ -0,0 +1,1024 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "lifecycle.h"
+#include "binary.h"
+#include "type.h"
+#include "world.h"
+
+/* A registry snapshot stores all types that have a serializer, with their type
+ * specific data and compiled type operations. Snapshots contain sizes and
+ * offsets of the host that created them, and can only be loaded by a build
+ * with the same ABI. Types are referenced by their index in the snapshot plus
+ * one, so that 0 can indicate no type. Strings are stored with their
+ * terminator, so that they can be used from the loaded snapshot in place.
+ *
+ * The header contains a magic number, format version, ABI tag, type count and
+ * a fingerprint of the payload. */
+
+#define REGISTRY_MAGIC (0x47524d46u) /* FMRG */
+#define REGISTRY_VERSION (1u)
+#define REGISTRY_HEADER_SIZE (ECS_SIZEOF(uint32_t) * 4 + ECS_SIZEOF(uint64_t))
+
+#ifdef ECS_META_BIN_LITTLE_ENDIAN
+#define REGISTRY_ABI_ENDIAN (1u)
+#else
+#define REGISTRY_ABI_ENDIAN (0u)
+#endif
+
+#define REGISTRY_ABI\
+    ((uint32_t)sizeof(void*) |\
+     ((uint32_t)sizeof(ecs_map_key_t) << 8) |\
+     ((uint32_t)ECS_ALIGNOF(int64_t) << 16) |\
+     (REGISTRY_ABI_ENDIAN << 24))
+
+typedef struct reg_member_t {
+    const char *name;
+    uint32_t type;
+} reg_member_t;
+
+typedef struct reg_constant_t {
+    ecs_map_key_t value;
+    const char *name;
+} reg_constant_t;
+
+typedef struct reg_type_t {
+    const char *path;
+    EcsMetaType type;
+    bool is_component;
+
+    /* Type specific data */
+    ecs_primitive_kind_t primitive;
+    ecs_vector_t *members;      /* vector<reg_member_t> */
+    ecs_vector_t *constants;    /* vector<reg_constant_t> */
+    bool is_partial;
+    uint32_t key_type;
+    uint32_t element_type;
+    int32_t count;
+
+    /* Serializer. Entities in ops are stored as type indices until the types
+     * are resolved. */
+    ecs_vector_t *ops;
+    ecs_vector_t *opt_ops;
+    bool is_pod;
+    bool owns_heap;
+    bool has_entities;
+    bool has_floats;
+    int32_t max_depth;
+
+    ecs_entity_t entity;
+    bool exists;        /* Type is already registered in the world */
+    bool is_needed;     /* Type must be created */
+} reg_type_t;
+
+typedef struct reg_handles_t {
+    ecs_entity_t meta_type;
+    ecs_entity_t serializer;
+    ecs_entity_t primitive;
+    ecs_entity_t enum_type;
+    ecs_entity_t bitmask;
+    ecs_entity_t struct_type;
+    ecs_entity_t array;
+    ecs_entity_t vector;
+    ecs_entity_t map;
+} reg_handles_t;
+
+static
+void get_handles(
+    ecs_world_t *world,
+    reg_handles_t *h)
+{
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+
+    h->meta_type = module->ecs_entity(EcsMetaType);
+    h->serializer = module->ecs_entity(EcsMetaTypeSerializer);
+    h->primitive = module->ecs_entity(EcsPrimitive);
+    h->enum_type = module->ecs_entity(EcsEnum);
+    h->bitmask = module->ecs_entity(EcsBitmask);
+    h->struct_type = module->ecs_entity(EcsStruct);
+    h->array = module->ecs_entity(EcsArray);
+    h->vector = module->ecs_entity(EcsVector);
+    h->map = module->ecs_entity(EcsMap);
+}
+
+/* FNV-1a */
+static
+uint64_t fingerprint(
+    const uint8_t *ptr,
+    ecs_size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    ecs_size_t i;
+    for (i = 0; i < size; i ++) {
+        hash ^= ptr[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/* -- Saving -- */
+
+static
+void write_str(
+    ecs_vector_t **out,
+    const char *str)
+{
+    if (!str) {
+        ecs_meta_bin_write_u32(out, ECS_META_BIN_NULL_STR);
+        return;
+    }
+
+    ecs_size_t len = ecs_os_strlen(str);
+    ecs_meta_bin_write_u32(out, (uint32_t)len);
+    ecs_meta_bin_write_bytes(out, str, len + 1);
+}
+
+static
+int write_type_ref(
+    ecs_vector_t **out,
+    ecs_map_t *index,
+    ecs_entity_t type)
+{
+    if (!type) {
+        ecs_meta_bin_write_u32(out, 0);
+        return 0;
+    }
+
+    int32_t *i = ecs_map_get(index, int32_t, type);
+    if (!i) {
+        return -1;
+    }
+
+    ecs_meta_bin_write_u32(out, (uint32_t)*i + 1);
+    return 0;
+}
+
+static
+int write_ops(
+    ecs_vector_t **out,
+    ecs_map_t *index,
+    ecs_vector_t *ops)
+{
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ops);
+
+    ecs_meta_bin_write_u32(out, (uint32_t)count);
+
+    for (i = 0; i < count; i ++) {
+        if (write_type_ref(out, index, op[i].type)) {
+            return -1;
+        }
+
+        ecs_meta_bin_write_u32(out, op[i].kind);
+        ecs_meta_bin_write_u32(out, (uint32_t)op[i].size);
+        ecs_meta_bin_write_u32(out, (uint32_t)op[i].alignment);
+        ecs_meta_bin_write_u32(out, (uint32_t)op[i].count);
+        ecs_meta_bin_write_u32(out, (uint32_t)op[i].offset);
+        write_str(out, op[i].name);
+
+        int ret = 0;
+        switch(op[i].kind) {
+        case EcsOpPrimitive:
+            ecs_meta_bin_write_u32(out, op[i].is.primitive);
+            break;
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            ret = write_type_ref(out, index, op[i].is.constant.entity);
+            break;
+        case EcsOpArray:
+        case EcsOpVector:
+            ret = write_type_ref(out, index, op[i].is.collection.ref.entity);
+            break;
+        case EcsOpMap:
+            ret = write_type_ref(out, index, op[i].is.map.key.ref.entity);
+            ret |= write_type_ref(out, index, op[i].is.map.element.ref.entity);
+            break;
+        default:
+            break;
+        }
+
+        if (ret) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+void write_constants(
+    ecs_vector_t **out,
+    ecs_map_t *constants)
+{
+    ecs_meta_bin_write_u32(out, (uint32_t)ecs_map_count(constants));
+
+    ecs_map_iter_t it = ecs_map_iter(constants);
+    ecs_map_key_t key;
+    char **name;
+
+    while ((name = _ecs_map_next(&it, ECS_SIZEOF(char*), &key))) {
+        ecs_meta_bin_write_bytes(out, &key, ECS_SIZEOF(ecs_map_key_t));
+        write_str(out, *name);
+    }
+}
+
+static
+int write_type(
+    ecs_world_t *world,
+    reg_handles_t *h,
+    ecs_map_t *index,
+    ecs_entity_t e,
+    ecs_vector_t **out)
+{
+    const EcsMetaType *type = ecs_get_w_entity(world, e, h->meta_type);
+    const EcsMetaTypeSerializer *ser = ecs_get_w_entity(
+        world, e, h->serializer);
+    ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (ecs_get_name(world, e)) {
+        char *path = ecs_get_fullpath(world, e);
+        write_str(out, path);
+        ecs_os_free(path);
+    } else {
+        write_str(out, NULL);
+    }
+
+    ecs_meta_bin_write_u32(out, type->kind);
+    ecs_meta_bin_write_u32(out, (uint32_t)type->size);
+    ecs_meta_bin_write_u32(out, (uint32_t)type->alignment);
+    write_str(out, type->descriptor);
+    ecs_meta_bin_write_u32(out,
+        ecs_get_w_entity(world, e, ecs_entity(EcsComponent)) != NULL);
+
+    int ret = 0;
+    switch(type->kind) {
+    case EcsPrimitiveType: {
+        const EcsPrimitive *t = ecs_get_w_entity(world, e, h->primitive);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_meta_bin_write_u32(out, t->kind);
+        break;
+    }
+    case EcsEnumType: {
+        const EcsEnum *t = ecs_get_w_entity(world, e, h->enum_type);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        write_constants(out, t->constants);
+        break;
+    }
+    case EcsBitmaskType: {
+        const EcsBitmask *t = ecs_get_w_entity(world, e, h->bitmask);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        write_constants(out, t->constants);
+        break;
+    }
+    case EcsStructType: {
+        const EcsStruct *t = ecs_get_w_entity(world, e, h->struct_type);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        EcsMember *m = ecs_vector_first(t->members, EcsMember);
+        int32_t i, count = ecs_vector_count(t->members);
+
+        ecs_meta_bin_write_u32(out, t->is_partial);
+        ecs_meta_bin_write_u32(out, (uint32_t)count);
+        for (i = 0; i < count; i ++) {
+            write_str(out, m[i].name);
+            ret |= write_type_ref(out, index, m[i].type);
+        }
+        break;
+    }
+    case EcsArrayType: {
+        const EcsArray *t = ecs_get_w_entity(world, e, h->array);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        ret = write_type_ref(out, index, t->element_type);
+        ecs_meta_bin_write_u32(out, (uint32_t)t->count);
+        break;
+    }
+    case EcsVectorType: {
+        const EcsVector *t = ecs_get_w_entity(world, e, h->vector);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        ret = write_type_ref(out, index, t->element_type);
+        break;
+    }
+    case EcsMapType: {
+        const EcsMap *t = ecs_get_w_entity(world, e, h->map);
+        ecs_assert(t != NULL, ECS_INTERNAL_ERROR, NULL);
+        ret = write_type_ref(out, index, t->key_type);
+        ret |= write_type_ref(out, index, t->element_type);
+        break;
+    }
+    }
+
+    if (ret) {
+        return -1;
+    }
+
+    ecs_meta_bin_write_u32(out, (uint32_t)(ser->is_pod |
+        (ser->owns_heap << 1) | (ser->has_entities << 2) | 
+        (ser->has_floats << 3)));
+    ecs_meta_bin_write_u32(out, (uint32_t)ser->max_depth);
+
+    if (write_ops(out, index, ser->ops)) {
+        return -1;
+    }
+
+    return write_ops(out, index, ser->opt_ops);
+}
+
+int ecs_meta_save_registry(
+    ecs_world_t *world,
+    ecs_vector_t **out)
+{
+    reg_handles_t h;
+    get_handles(world, &h);
+
+    /* Collect types, so that they can be referenced by index */
+    ecs_vector_t *types = NULL;
+    ecs_map_t *index = ecs_map_new(int32_t, 0);
+
+    ecs_filter_t filter = {
+        .include = ecs_type_from_entity(world, h.serializer)
+    };
+
+    ecs_iter_t it = ecs_filter_iter(world, &filter);
+    while (ecs_filter_next(&it)) {
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            ecs_entity_t e = it.entities[i];
+            if (!ecs_get_w_entity(world, e, h.meta_type)) {
+                continue;
+            }
+
+            int32_t type_index = ecs_vector_count(types);
+            ecs_map_set(index, e, &type_index);
+            *ecs_vector_add(&types, ecs_entity_t) = e;
+        }
+    }
+
+    int32_t start = ecs_vector_count(*out);
+    ecs_meta_bin_write_u32(out, REGISTRY_MAGIC);
+    ecs_meta_bin_write_u32(out, REGISTRY_VERSION);
+    ecs_meta_bin_write_u32(out, REGISTRY_ABI);
+    ecs_meta_bin_write_u32(out, (uint32_t)ecs_vector_count(types));
+    uint64_t hash = 0;
+    ecs_meta_bin_write_bytes(out, &hash, ECS_SIZEOF(uint64_t));
+
+    ecs_entity_t *entities = ecs_vector_first(types, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(types);
+    int ret = 0;
+
+    for (i = 0; i < count; i ++) {
+        if (write_type(world, &h, index, entities[i], out)) {
+            ret = -1;
+            break;
+        }
+    }
+
+    ecs_vector_free(types);
+    ecs_map_free(index);
+
+    if (ret) {
+        ecs_vector_set_count(out, uint8_t, start);
+        return -1;
+    }
+
+    /* Fingerprint covers everything after the header */
+    uint8_t *blob = ecs_vector_get(*out, uint8_t, start);
+    ecs_size_t size = ecs_vector_count(*out) - start;
+    hash = fingerprint(blob + REGISTRY_HEADER_SIZE, size - REGISTRY_HEADER_SIZE);
+    ecs_os_memcpy(blob + REGISTRY_HEADER_SIZE - ECS_SIZEOF(uint64_t),
+        &hash, ECS_SIZEOF(uint64_t));
+
+    return 0;
+}
+
+/* -- Loading -- */
+
+static
+int read_str(
+    ecs_meta_bin_reader_t *r,
+    const char **out)
+{
+    uint32_t len;
+    if (ecs_meta_bin_read_u32(r, &len)) {
+        return -1;
+    }
+
+    if (len == ECS_META_BIN_NULL_STR) {
+        *out = NULL;
+        return 0;
+    }
+
+    if ((uint64_t)(r->end - r->ptr) <= len || r->ptr[len] != '\0') {
+        return -1;
+    }
+
+    *out = (const char*)r->ptr;
+    r->ptr += len + 1;
+
+    return 0;
+}
+
+static
+int read_type_ref(
+    ecs_meta_bin_reader_t *r,
+    uint32_t type_count,
+    uint32_t *out)
+{
+    if (ecs_meta_bin_read_u32(r, out)) {
+        return -1;
+    }
+
+    return *out > type_count ? -1 : 0;
+}
+
+static
+int read_i32(
+    ecs_meta_bin_reader_t *r,
+    int32_t *out)
+{
+    uint32_t value;
+    if (ecs_meta_bin_read_u32(r, &value) || value > ECS_MAX_I32) {
+        return -1;
+    }
+
+    *out = (int32_t)value;
+    return 0;
+}
+
+static
+int read_ops(
+    ecs_meta_bin_reader_t *r,
+    uint32_t type_count,
+    ecs_vector_t **ops)
+{
+    int32_t i, count;
+    if (read_i32(r, &count)) {
+        return -1;
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_type_op_t *op = ecs_vector_add(ops, ecs_type_op_t);
+        ecs_os_memset(op, 0, ECS_SIZEOF(ecs_type_op_t));
+
+        uint32_t type, kind, alignment;
+        if (read_type_ref(r, type_count, &type) ||
+            ecs_meta_bin_read_u32(r, &kind) || kind > EcsOpBlit ||
+            read_i32(r, &op->size) ||
+            ecs_meta_bin_read_u32(r, &alignment) || alignment > INT16_MAX ||
+            read_i32(r, &op->count) ||
+            read_i32(r, &op->offset) ||
+            read_str(r, &op->name))
+        {
+            return -1;
+        }
+
+        op->type = type;
+        op->kind = (ecs_type_op_kind_t)kind;
+        op->alignment = (int16_t)alignment;
+
+        uint32_t key = 0, elem = 0;
+        switch(op->kind) {
+        case EcsOpPrimitive:
+            if (ecs_meta_bin_read_u32(r, &elem) || elem > EcsEntity) {
+                return -1;
+            }
+            op->is.primitive = (ecs_primitive_kind_t)elem;
+            break;
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            if (read_type_ref(r, type_count, &elem) || !elem) {
+                return -1;
+            }
+            op->is.constant.entity = elem;
+            break;
+        case EcsOpArray:
+        case EcsOpVector:
+            if (read_type_ref(r, type_count, &elem) || !elem) {
+                return -1;
+            }
+            op->is.collection.ref.entity = elem;
+            break;
+        case EcsOpMap:
+            if (read_type_ref(r, type_count, &key) || !key ||
+                read_type_ref(r, type_count, &elem) || !elem)
+            {
+                return -1;
+            }
+            op->is.map.key.ref.entity = key;
+            op->is.map.element.ref.entity = elem;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return 0;
+}
+
+static
+int read_constants(
+    ecs_meta_bin_reader_t *r,
+    ecs_vector_t **constants)
+{
+    int32_t i, count;
+    if (read_i32(r, &count)) {
+        return -1;
+    }
+
+    for (i = 0; i < count; i ++) {
+        reg_constant_t *c = ecs_vector_add(constants, reg_constant_t);
+        if (ecs_meta_bin_read_bytes(r, &c->value, ECS_SIZEOF(ecs_map_key_t)) ||
+            read_str(r, &c->name) || !c->name)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int read_type(
+    ecs_meta_bin_reader_t *r,
+    uint32_t type_count,
+    reg_type_t *t)
+{
+    uint32_t kind, alignment, is_component, value;
+    if (read_str(r, &t->path) ||
+        ecs_meta_bin_read_u32(r, &kind) || kind > EcsMapType ||
+        read_i32(r, &t->type.size) ||
+        ecs_meta_bin_read_u32(r, &alignment) || alignment > INT16_MAX ||
+        read_str(r, &t->type.descriptor) ||
+        ecs_meta_bin_read_u32(r, &is_component))
+    {
+        return -1;
+    }
+
+    t->type.kind = (ecs_type_kind_t)kind;
+    t->type.alignment = (int16_t)alignment;
+    t->is_component = is_component != 0;
+
+    switch(t->type.kind) {
+    case EcsPrimitiveType:
+        if (ecs_meta_bin_read_u32(r, &value) || value > EcsEntity) {
+            return -1;
+        }
+        t->primitive = (ecs_primitive_kind_t)value;
+        break;
+    case EcsEnumType:
+    case EcsBitmaskType:
+        if (read_constants(r, &t->constants)) {
+            return -1;
+        }
+        break;
+    case EcsStructType: {
+        int32_t i, count;
+        if (ecs_meta_bin_read_u32(r, &value) || read_i32(r, &count)) {
+            return -1;
+        }
+
+        t->is_partial = value != 0;
+
+        for (i = 0; i < count; i ++) {
+            reg_member_t *m = ecs_vector_add(&t->members, reg_member_t);
+            if (read_str(r, &m->name) || !m->name ||
+                read_type_ref(r, type_count, &m->type) || !m->type)
+            {
+                return -1;
+            }
+        }
+        break;
+    }
+    case EcsArrayType:
+        if (read_type_ref(r, type_count, &t->element_type) ||
+            !t->element_type || read_i32(r, &t->count))
+        {
+            return -1;
+        }
+        break;
+    case EcsVectorType:
+        if (read_type_ref(r, type_count, &t->element_type) ||
+            !t->element_type)
+        {
+            return -1;
+        }
+        break;
+    case EcsMapType:
+        if (read_type_ref(r, type_count, &t->key_type) || !t->key_type ||
+            read_type_ref(r, type_count, &t->element_type) ||
+            !t->element_type)
+        {
+            return -1;
+        }
+        break;
+    }
+
+    if (ecs_meta_bin_read_u32(r, &value) || read_i32(r, &t->max_depth)) {
+        return -1;
+    }
+
+    t->is_pod = (value & 1) != 0;
+    t->owns_heap = (value & 2) != 0;
+    t->has_entities = (value & 4) != 0;
+    t->has_floats = (value & 8) != 0;
+
+    if (read_ops(r, type_count, &t->ops) ||
+        read_ops(r, type_count, &t->opt_ops))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+static
+void free_types(
+    reg_type_t *types,
+    int32_t count)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        ecs_vector_free(types[i].members);
+        ecs_vector_free(types[i].constants);
+        ecs_vector_free(types[i].ops);
+        ecs_vector_free(types[i].opt_ops);
+    }
+
+    ecs_os_free(types);
+}
+
+static
+void mark_needed(
+    reg_type_t *types,
+    uint32_t index);
+
+static
+void mark_ops_needed(
+    reg_type_t *types,
+    ecs_vector_t *ops)
+{
+    ecs_vector_each(ops, ecs_type_op_t, op, {
+        switch(op->kind) {
+        case EcsOpEnum:
+        case EcsOpBitmask:
+            mark_needed(types, (uint32_t)op->is.constant.entity);
+            break;
+        case EcsOpArray:
+        case EcsOpVector:
+            mark_needed(types, (uint32_t)op->is.collection.ref.entity);
+            break;
+        case EcsOpMap:
+            mark_needed(types, (uint32_t)op->is.map.key.ref.entity);
+            mark_needed(types, (uint32_t)op->is.map.element.ref.entity);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+/* Anonymous types, like the vector type of a struct member, are only created
+ * if they are used by a type that is created. */
+static
+void mark_needed(
+    reg_type_t *types,
+    uint32_t index)
+{
+    if (!index) {
+        return;
+    }
+
+    reg_type_t *t = &types[index - 1];
+    if (t->exists || t->is_needed) {
+        return;
+    }
+
+    t->is_needed = true;
+
+    ecs_vector_each(t->members, reg_member_t, m, {
+        mark_needed(types, m->type);
+    });
+
+    mark_needed(types, t->key_type);
+    mark_needed(types, t->element_type);
+    mark_ops_needed(types, t->ops);
+}
+
+static
+ecs_entity_t type_entity(
+    reg_type_t *types,
+    uint32_t index)
+{
+    return index ? types[index - 1].entity : 0;
+}
+
+/* Replace type indices in ops with entities */
+static
+void resolve_ops(
+    reg_handles_t *h,
+    reg_type_t *types,
+    ecs_vector_t *ops)
+{
+    ecs_vector_each(ops, ecs_type_op_t, op, {
+        op->type = type_entity(types, (uint32_t)op->type);
+
+        switch(op->kind) {
+        case EcsOpEnum:
+            op->is.constant = (ecs_ref_t){
+                .entity = type_entity(types, (uint32_t)op->is.constant.entity),
+                .component = h->enum_type
+            };
+            break;
+        case EcsOpBitmask:
+            op->is.constant = (ecs_ref_t){
+                .entity = type_entity(types, (uint32_t)op->is.constant.entity),
+                .component = h->bitmask
+            };
+            break;
+        case EcsOpArray:
+        case EcsOpVector:
+            op->is.collection = (ecs_type_op_ref_t){
+                .ref = {
+                    .entity = type_entity(
+                        types, (uint32_t)op->is.collection.ref.entity),
+                    .component = h->serializer
+                }
+            };
+            break;
+        case EcsOpMap:
+            op->is.map.key = (ecs_type_op_ref_t){
+                .ref = {
+                    .entity = type_entity(
+                        types, (uint32_t)op->is.map.key.ref.entity),
+                    .component = h->serializer
+                }
+            };
+            op->is.map.element = (ecs_type_op_ref_t){
+                .ref = {
+                    .entity = type_entity(
+                        types, (uint32_t)op->is.map.element.ref.entity),
+                    .component = h->serializer
+                }
+            };
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+static
+ecs_map_t* new_constants(
+    ecs_vector_t *constants)
+{
+    ecs_map_t *result = ecs_map_new(char*, ecs_vector_count(constants));
+    ecs_vector_each(constants, reg_constant_t, c, {
+        char *name = ecs_os_strdup(c->name);
+        ecs_map_set(result, c->value, &name);
+    });
+    return result;
+}
+
+/* Components are assigned with ecs_get_mut and without ecs_modified, so that
+ * the OnSet systems that would parse and compile the type again do not run. */
+static
+void apply_type(
+    ecs_world_t *world,
+    reg_handles_t *h,
+    reg_type_t *types,
+    reg_type_t *t)
+{
+    ecs_entity_t e = t->entity;
+
+    EcsMetaType *type = ecs_get_mut_w_entity(world, e, h->meta_type, NULL);
+    *type = t->type;
+
+    switch(t->type.kind) {
+    case EcsPrimitiveType: {
+        EcsPrimitive *p = ecs_get_mut_w_entity(world, e, h->primitive, NULL);
+        p->kind = t->primitive;
+        break;
+    }
+    case EcsEnumType: {
+        EcsEnum *p = ecs_get_mut_w_entity(world, e, h->enum_type, NULL);
+        p->constants = new_constants(t->constants);
+        ecs_meta_enum_init(p);
+        break;
+    }
+    case EcsBitmaskType: {
+        EcsBitmask *p = ecs_get_mut_w_entity(world, e, h->bitmask, NULL);
+        p->constants = new_constants(t->constants);
+        ecs_meta_bitmask_init(p);
+        break;
+    }
+    case EcsStructType: {
+        EcsStruct *p = ecs_get_mut_w_entity(world, e, h->struct_type, NULL);
+        p->is_partial = t->is_partial;
+        ecs_vector_each(t->members, reg_member_t, m, {
+            EcsMember *member = ecs_vector_add(&p->members, EcsMember);
+            member->name = ecs_os_strdup(m->name);
+            member->type = type_entity(types, m->type);
+        });
+        break;
+    }
+    case EcsArrayType: {
+        EcsArray *p = ecs_get_mut_w_entity(world, e, h->array, NULL);
+        p->element_type = type_entity(types, t->element_type);
+        p->count = t->count;
+        if (!t->path) {
+            ecs_meta_intern(world, EcsArrayType, 0, p->element_type, 
+                p->count, e);
+        }
+        break;
+    }
+    case EcsVectorType: {
+        EcsVector *p = ecs_get_mut_w_entity(world, e, h->vector, NULL);
+        p->element_type = type_entity(types, t->element_type);
+        if (!t->path) {
+            ecs_meta_intern(world, EcsVectorType, 0, p->element_type, 0, e);
+        }
+        break;
+    }
+    case EcsMapType: {
+        EcsMap *p = ecs_get_mut_w_entity(world, e, h->map, NULL);
+        p->key_type = type_entity(types, t->key_type);
+        p->element_type = type_entity(types, t->element_type);
+        if (!t->path) {
+            ecs_meta_intern(world, EcsMapType, p->key_type, 
+                p->element_type, 0, e);
+        }
+        break;
+    }
+    }
+
+    resolve_ops(h, types, t->ops);
+    resolve_ops(h, types, t->opt_ops);
+
+    EcsMetaTypeSerializer *ser = ecs_get_mut_w_entity(
+        world, e, h->serializer, NULL);
+    ser->ops = t->ops;
+    ser->opt_ops = t->opt_ops;
+    ser->members = ecs_meta_index_members(t->ops);
+    ser->is_pod = t->is_pod;
+    ser->owns_heap = t->owns_heap;
+    ser->has_entities = t->has_entities;
+    ser->has_floats = t->has_floats;
+    ser->max_depth = t->max_depth;
+    ecs_meta_cache_serializer(world, e, ser);
+
+    /* Ownership of ops is transferred to the serializer */
+    t->ops = NULL;
+    t->opt_ops = NULL;
+
+    if (t->is_component) {
+        ecs_meta_init_lifecycle(world, e, ser);
+    }
+}
+
+static
+void free_snapshot(
+    ecs_world_t *world,
+    void *ctx)
+{
+    (void)world;
+    ecs_os_free(ctx);
+}
+
+int ecs_meta_load_registry(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size)
+{
+    reg_handles_t h;
+    get_handles(world, &h);
+
+    if (size < REGISTRY_HEADER_SIZE) {
+        return -1;
+    }
+
+    ecs_meta_bin_reader_t r = {
+        .ptr = data,
+        .end = ECS_OFFSET(data, size)
+    };
+
+    uint32_t magic, version, abi, type_count;
+    uint64_t hash;
+    ecs_meta_bin_read_u32(&r, &magic);
+    ecs_meta_bin_read_u32(&r, &version);
+    ecs_meta_bin_read_u32(&r, &abi);
+    ecs_meta_bin_read_u32(&r, &type_count);
+    ecs_meta_bin_read_bytes(&r, &hash, ECS_SIZEOF(uint64_t));
+
+    if (magic != REGISTRY_MAGIC || version != REGISTRY_VERSION ||
+        abi != REGISTRY_ABI || type_count > ECS_MAX_I32)
+    {
+        return -1;
+    }
+
+    if (hash != fingerprint(r.ptr, size - REGISTRY_HEADER_SIZE)) {
+        return -1;
+    }
+
+    /* Strings in the loaded types point into a copy of the snapshot, which is
+     * kept alive until the world is deleted */
+    uint8_t *snapshot = ecs_os_malloc(size);
+    ecs_os_memcpy(snapshot, data, size);
+    r.ptr = snapshot + REGISTRY_HEADER_SIZE;
+    r.end = snapshot + size;
+
+    int32_t i, count = (int32_t)type_count;
+    reg_type_t *types = ecs_os_calloc(ECS_SIZEOF(reg_type_t) * count);
+
+    for (i = 0; i < count; i ++) {
+        if (read_type(&r, type_count, &types[i])) {
+            goto error;
+        }
+    }
+
+    if (r.ptr != r.end) {
+        goto error;
+    }
+
+    /* Types that are already registered must have the same definition, or the
+     * snapshot does not belong to this world */
+    for (i = 0; i < count; i ++) {
+        if (!types[i].path) {
+            continue;
+        }
+
+        ecs_entity_t e = ecs_lookup_fullpath(world, types[i].path);
+        if (!e) {
+            continue;
+        }
+
+        const EcsMetaType *type = ecs_get_w_entity(world, e, h.meta_type);
+        if (type) {
+            if (!ecs_meta_type_equal(type, &types[i].type) ||
+                !ecs_get_w_entity(world, e, h.serializer))
+            {
+                goto error;
+            }
+
+            types[i].exists = true;
+        }
+
+        types[i].entity = e;
+    }
+
+    for (i = 0; i < count; i ++) {
+        if (types[i].path) {
+            mark_needed(types, (uint32_t)i + 1);
+        }
+    }
+
+    /* Snapshot is valid, create the entities for the new types */
+    for (i = 0; i < count; i ++) {
+        reg_type_t *t = &types[i];
+        if (!t->is_needed) {
+            continue;
+        }
+
+        if (!t->entity) {
+            if (t->path) {
+                t->entity = ecs_new_from_fullpath(world, t->path);
+            } else {
+                t->entity = ecs_new(world, 0);
+            }
+        }
+
+        if (t->is_component) {
+            ecs_new_component(world, t->entity, NULL,
+                (size_t)t->type.size, (size_t)t->type.alignment);
+        }
+    }
+
+    for (i = 0; i < count; i ++) {
+        if (types[i].is_needed) {
+            apply_type(world, &h, types, &types[i]);
+        }
+    }
+
+    /* Resolve references to ops once all serializers are created. Compare
+     * ops are not stored in the snapshot, as they depend on the element types
+     * of arrays. */
+    for (i = 0; i < count; i ++) {
+        if (types[i].is_needed) {
+            EcsMetaTypeSerializer *ser = ecs_get_mut_w_entity(
+                world, types[i].entity, h.serializer, NULL);
+            ecs_meta_resolve_refs(world, ser->ops);
+            ecs_meta_resolve_refs(world, ser->opt_ops);
+            ecs_vector_free(ser->cmp_ops);
+            ser->cmp_ops = ecs_meta_optimize_compare_ops(world, ser);
+            ecs_meta_cache_serializer(world, types[i].entity, ser);
+            ecs_meta_add_dependencies(world, types[i].entity, ser->ops);
+        }
+    }
+
+    free_types(types, count);
+    ecs_atfini(world, free_snapshot, snapshot);
+
+    return 0;
+error:
+    free_types(types, count);
+    ecs_os_free(snapshot);
+    return -1;
+}
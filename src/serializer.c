@@ -1,5 +1,8 @@
 #include <flecs_meta.h>
 #include "parser.h"
+#include "serializer.h"
+#include "type.h"
+#include "world.h"
 
 static
 ecs_vector_t* serialize_type(
@@ -63,6 +66,102 @@ int16_t ecs_get_primitive_alignment(
     }
 }
 
+static
+ecs_type_op_ref_t op_ref_init(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    FlecsMeta *module)
+{
+    FlecsMetaImportHandles(*module);
+
+    ecs_type_op_ref_t result = {0};
+    const EcsMetaTypeSerializer *ser = ecs_get_ref(
+        world, &result.ref, type, EcsMetaTypeSerializer);
+
+    /* If the type is not serialized yet, ops are resolved when it is */
+    if (ser) {
+        result.ops = ser->ops;
+    }
+
+    return result;
+}
+
+ecs_vector_t* ecs_type_op_ref_get(
+    ecs_world_t *world,
+    ecs_type_op_ref_t *ref)
+{
+    (void)world;
+    ecs_assert(ref->ops != NULL, ECS_INTERNAL_ERROR, NULL);
+    return ref->ops;
+}
+
+const EcsMetaTypeSerializer* ecs_type_op_ref_serializer(
+    ecs_world_t *world,
+    ecs_type_op_ref_t *ref)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(
+        world, ref->ref.entity);
+    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+    return ser;
+}
+
+const EcsMetaTypeSerializer* ecs_meta_type_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(world, type);
+    ecs_assert(ser != NULL, ECS_INVALID_PARAMETER, NULL);
+    return ser;
+}
+
+static
+void ref_resolve(
+    ecs_world_t *world,
+    ecs_type_op_ref_t *ref,
+    ecs_entity_t entity,
+    ecs_vector_t *ops)
+{
+    if (!entity) {
+        const EcsMetaTypeSerializer *ser = ecs_meta_get_serializer(
+            world, ref->ref.entity);
+        ref->ops = ser ? ser->ops : NULL;
+    } else if (ref->ref.entity == entity) {
+        ref->ops = ops;
+    }
+}
+
+/* Point references to the ops of entity to the provided ops. If entity is 0,
+ * all references are resolved from the serializers of the referenced types. */
+static
+void refs_resolve(
+    ecs_world_t *world,
+    ecs_vector_t *ops,
+    ecs_entity_t entity,
+    ecs_vector_t *entity_ops)
+{
+    ecs_vector_each(ops, ecs_type_op_t, op, {
+        switch(op->kind) {
+        case EcsOpArray:
+        case EcsOpVector:
+            ref_resolve(world, &op->is.collection, entity, entity_ops);
+            break;
+        case EcsOpMap:
+            ref_resolve(world, &op->is.map.key, entity, entity_ops);
+            ref_resolve(world, &op->is.map.element, entity, entity_ops);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+void ecs_meta_resolve_refs(
+    ecs_world_t *world,
+    ecs_vector_t *ops)
+{
+    refs_resolve(world, ops, 0, NULL);
+}
+
 static
 ecs_vector_t* serialize_primitive(
     ecs_world_t *world,
@@ -216,8 +315,9 @@ ecs_vector_t* serialize_struct(
         op = ecs_vector_get(ops, ecs_type_op_t, prev_count);
         op->name = members[i].name;
 
+        /* The meta type size already includes the element count of arrays */
         const EcsMetaType *meta_type = ecs_get(world, members[i].type, EcsMetaType);
-        ecs_size_t member_size = meta_type->size * op->count;
+        ecs_size_t member_size = meta_type->size;
         int16_t member_alignment = meta_type->alignment;
 
         ecs_assert(member_size != 0, ECS_INTERNAL_ERROR, op->name);
@@ -328,23 +428,20 @@ ecs_vector_t* serialize_array(
     const EcsMetaType *element_type = ecs_get(world, type->element_type, EcsMetaType);
     ecs_assert(element_type != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_ref_t ref = {0};
-    ecs_get_ref(world, &ref, type->element_type, EcsMetaTypeSerializer);
-
     ecs_type_op_t *op = ecs_vector_add(&ops, ecs_type_op_t);
     *op = (ecs_type_op_t){
         .kind = EcsOpArray, 
         .count = type->count,
         .size = element_type->size,
         .alignment = element_type->alignment,
-        .is.collection = ref
+        .is.collection = op_ref_init(world, type->element_type, handles)
     };
 
     if (op_header) {
         op_header = ecs_vector_first(ops, ecs_type_op_t);
         *op_header = (ecs_type_op_t) {
             .kind = EcsOpHeader,
-            .size = op->size,
+            .size = op->size * op->count,
             .alignment = op->alignment
         };            
     }        
@@ -377,16 +474,13 @@ ecs_vector_t* serialize_vector(
     const EcsMetaType *element_type = ecs_get(world, type->element_type, EcsMetaType);
     ecs_assert(element_type != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    ecs_ref_t ref = {0};
-    ecs_get_ref(world, &ref, type->element_type, EcsMetaTypeSerializer);
-
     op = ecs_vector_add(&ops, ecs_type_op_t);
     *op = (ecs_type_op_t){
         .kind = EcsOpVector, 
         .count = 1,
         .size = element_type->size,
         .alignment = element_type->alignment,
-        .is.collection = ref
+        .is.collection = op_ref_init(world, type->element_type, handles)
     };
 
     return ops;
@@ -448,12 +542,6 @@ ecs_vector_t* serialize_map(
         ecs_meta_error( &ctx, ctx.decl, "array type invalid for key type");
     }
 
-    ecs_ref_t key_ref = {0};
-    ecs_get_ref(world, &key_ref, type->key_type, EcsMetaTypeSerializer);
-
-    ecs_ref_t element_ref = {0};
-    ecs_get_ref(world, &element_ref, type->element_type, EcsMetaTypeSerializer);
-
     op = ecs_vector_add(&ops, ecs_type_op_t);
     *op = (ecs_type_op_t){
         .kind = EcsOpMap, 
@@ -461,8 +549,8 @@ ecs_vector_t* serialize_map(
         .size = sizeof(ecs_map_t*),
         .alignment = ECS_ALIGNOF(ecs_map_t*),
         .is.map = {
-            .key = key_ref,
-            .element = element_ref
+            .key = op_ref_init(world, type->key_type, handles),
+            .element = op_ref_init(world, type->element_type, handles)
         }
     };
 
@@ -532,6 +620,139 @@ ecs_vector_t* serialize_type(
     return NULL;
 }
 
+void ecs_meta_add_dependencies(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t *ops)
+{
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
+    ecs_vector_each(ops, ecs_type_op_t, op, {
+        switch(op->kind) {
+        case EcsOpArray:
+        case EcsOpVector:
+            ecs_meta_add_dependent(
+                world, op->is.collection.ref.entity, entity, false);
+            break;
+        case EcsOpMap:
+            ecs_meta_add_dependent(
+                world, op->is.map.key.ref.entity, entity, false);
+            ecs_meta_add_dependent(
+                world, op->is.map.element.ref.entity, entity, false);
+            break;
+        default:
+            break;
+        }
+    });
+
+    const EcsStruct *type = ecs_get(world, entity, EcsStruct);
+    if (type) {
+        ecs_vector_each(type->members, EcsMember, m, {
+            ecs_meta_add_dependent(world, m->type, entity, true);
+        });
+    }
+}
+
+static
+void set_serializer(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t *ops,
+    FlecsMeta *module);
+
+/* Traits and optimized ops of a type depend on the traits of the element types
+ * of its collections. When a type changes, update the types that use it, and
+ * point their references to the ops of the type. Types that inline the ops of
+ * the type are serialized again. */
+static
+void update_dependents(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t *entity_ops,
+    FlecsMeta *module)
+{
+    FlecsMetaImportHandles(*module);
+
+    int32_t i;
+    for (i = 0; i < ecs_vector_count(ecs_meta_get_dependents(world, entity)); 
+        i ++) 
+    {
+        /* Vector may be reallocated by serializing a dependent */
+        ecs_meta_dependent_t dep = *ecs_vector_get(
+            ecs_meta_get_dependents(world, entity), ecs_meta_dependent_t, i);
+
+        /* References of a type to itself are resolved by set_serializer */
+        if (dep.type == entity || 
+            !ecs_get(world, dep.type, EcsMetaTypeSerializer)) 
+        {
+            continue;
+        }
+
+        if (dep.is_inline) {
+            set_serializer(world, dep.type, 
+                serialize_type(world, dep.type, NULL, 0, module), module);
+            continue;
+        }
+
+        EcsMetaTypeSerializer *ser = ecs_get_mut(
+            world, dep.type, EcsMetaTypeSerializer, NULL);
+        EcsMetaTypeSerializer prev = *ser;
+        refs_resolve(world, ser->ops, entity, entity_ops);
+        ecs_meta_compute_traits(world, ser);
+        ecs_vector_free(ser->opt_ops);
+        ecs_vector_free(ser->cmp_ops);
+        ser->opt_ops = ecs_meta_optimize_ops(world, ser->ops);
+        ser->cmp_ops = ecs_meta_optimize_compare_ops(world, ser);
+        ecs_meta_cache_serializer(world, dep.type, ser);
+
+        if (prev.is_pod != ser->is_pod || 
+            prev.owns_heap != ser->owns_heap ||
+            prev.has_entities != ser->has_entities ||
+            prev.has_floats != ser->has_floats ||
+            prev.max_depth != ser->max_depth) 
+        {
+            update_dependents(world, dep.type, ser->ops, module);
+        }
+    }
+}
+
+static
+void set_serializer(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t *ops,
+    FlecsMeta *module)
+{
+    FlecsMetaImportHandles(*module);
+
+    EcsMetaTypeSerializer *ser = ecs_get_mut(
+        world, entity, EcsMetaTypeSerializer, NULL);
+    ecs_assert(ser != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Free ops of previous definition. References to them are updated by
+     * update_dependents. */
+    if (ser->ops) {
+        ecs_vector_free(ser->ops);
+        ecs_vector_free(ser->opt_ops);
+        ecs_vector_free(ser->cmp_ops);
+        ecs_map_free(ser->members);
+    }
+
+    ser->ops = ops;
+    refs_resolve(world, ops, entity, ops);
+    ecs_meta_compute_traits(world, ser);
+    ser->opt_ops = ecs_meta_optimize_ops(world, ops);
+    ser->cmp_ops = ecs_meta_optimize_compare_ops(world, ser);
+    ser->members = ecs_meta_index_members(ops);
+    ecs_meta_cache_serializer(world, entity, ser);
+    ecs_modified(world, entity, EcsMetaTypeSerializer);
+
+    ecs_meta_add_dependencies(world, entity, ops);
+    update_dependents(world, entity, ops, module);
+}
+
 void EcsSetPrimitive(ecs_iter_t *it) {
     EcsPrimitive *type = ecs_column(it, EcsPrimitive, 1);
     ECS_IMPORT_COLUMN(it, FlecsMeta, 2);
@@ -552,10 +773,9 @@ void EcsSetPrimitive(ecs_iter_t *it) {
         base_type->size = ecs_get_primitive_size(type[i].kind);
         base_type->alignment = ecs_get_primitive_alignment(type[i].kind);
 
-        ecs_set(world, e, EcsMetaTypeSerializer, {
-            serialize_primitive(
-                world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+        set_serializer(world, e, serialize_primitive(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -569,9 +789,11 @@ void EcsSetEnum(ecs_iter_t *it) {
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
 
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_enum(world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+        ecs_meta_enum_init(&type[i]);
+
+        set_serializer(world, e, serialize_enum(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -584,9 +806,12 @@ void EcsSetBitmask(ecs_iter_t *it) {
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_bitmask(world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+
+        ecs_meta_bitmask_init(&type[i]);
+
+        set_serializer(world, e, serialize_bitmask(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -599,9 +824,9 @@ void EcsSetStruct(ecs_iter_t *it) {
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_struct(world, e, &type[i], NULL, 0, &ecs_module(FlecsMeta))
-        });
+        set_serializer(world, e, serialize_struct(
+            world, e, &type[i], NULL, 0, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -614,9 +839,9 @@ void EcsSetArray(ecs_iter_t *it) {
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_array(world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+        set_serializer(world, e, serialize_array(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -629,9 +854,9 @@ void EcsSetVector(ecs_iter_t *it) {
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_vector(world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+        set_serializer(world, e, serialize_vector(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
 
@@ -644,8 +869,8 @@ void EcsSetMap(ecs_iter_t *it) {
     int i;
     for (i = 0; i < it->count; i ++) {
         ecs_entity_t e = it->entities[i];
-        ecs_set(it->world, e, EcsMetaTypeSerializer, { 
-            serialize_map(world, e, &type[i], NULL, &ecs_module(FlecsMeta))
-        });
+        set_serializer(world, e, serialize_map(
+            world, e, &type[i], NULL, &ecs_module(FlecsMeta)), 
+                &ecs_module(FlecsMeta));
     }
 }
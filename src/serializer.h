@@ -27,4 +27,81 @@ void EcsSetVector(
 void EcsSetMap(
     ecs_iter_t *it);
 
+/* Get the ops of the type referenced by a collection or map op */
+ecs_vector_t* ecs_type_op_ref_get(
+    ecs_world_t *world,
+    ecs_type_op_ref_t *ref);
+
+/* Get the serializer of the type referenced by a collection or map op */
+const EcsMetaTypeSerializer* ecs_type_op_ref_serializer(
+    ecs_world_t *world,
+    ecs_type_op_ref_t *ref);
+
+/* Get the serializer of a type passed to the API. The type must have one. */
+const EcsMetaTypeSerializer* ecs_meta_type_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type);
+
+/* Compute traits of a type from its ops */
+void ecs_meta_compute_traits(
+    ecs_world_t *world,
+    EcsMetaTypeSerializer *ser);
+
+/* Create flattened copy of type ops where plain data is merged into blits */
+ecs_vector_t* ecs_meta_optimize_ops(
+    ecs_world_t *world,
+    ecs_vector_t *ops);
+
+/* Create optimized ops for comparing and hashing values, in which floating
+ * point members are kept apart from blits. Returns NULL if the type has no
+ * floating point members, as the optimized ops can be used in that case. */
+ecs_vector_t* ecs_meta_optimize_compare_ops(
+    ecs_world_t *world,
+    const EcsMetaTypeSerializer *ser);
+
+/* Test if a value of the type is a single blit without padding, in which case
+ * an array of values is one contiguous range of bytes */
+bool ecs_meta_is_contiguous(
+    const EcsMetaTypeSerializer *ser);
+
+/* Create index of named ops in each push/pop scope of type ops. Returns NULL
+ * if ops have no members, or if the index would contain hash collisions. */
+ecs_map_t* ecs_meta_index_members(
+    ecs_vector_t *ops);
+
+/* Find member in scope that starts at op index scope. Returns the op index of
+ * the member, or -1 if the scope has no member with the name. */
+int32_t ecs_meta_find_member(
+    ecs_map_t *members,
+    ecs_vector_t *ops,
+    int32_t scope,
+    const char *name);
+
+/* Get ops for comparing and hashing values of a type */
+ecs_vector_t* ecs_meta_compare_ops(
+    const EcsMetaTypeSerializer *ser);
+
+/* Test if values described by a range of type ops are equal */
+bool ecs_meta_ops_equal(
+    ecs_world_t *world,
+    ecs_type_op_t *ops,
+    int32_t op_count,
+    const void *a,
+    const void *b);
+
+/* Register the types that the serializer of entity depends on, so it is updated
+ * when they change. Member types of structs are inlined in the ops, element
+ * and key types of collections are referenced. */
+void ecs_meta_add_dependencies(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t *ops);
+
+/* Resolve references in ops to the ops of the referenced types. Serialized
+ * types keep their references up to date, this is only needed for ops that
+ * are not created by the serializer. */
+void ecs_meta_resolve_refs(
+    ecs_world_t *world,
+    ecs_vector_t *ops);
+
 #endif
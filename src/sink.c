@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include "sink.h"
+
+ecs_meta_sink_t ecs_meta_sink_buf(
+    char *buf,
+    ecs_size_t size)
+{
+    ecs_assert(buf != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+
+    return (ecs_meta_sink_t){
+        .buf = buf,
+        .size = size
+    };
+}
+
+ecs_meta_sink_t ecs_meta_sink_action(
+    ecs_meta_write_action_t action,
+    void *ctx,
+    char *buf,
+    ecs_size_t size)
+{
+    ecs_assert(action != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!buf || size > 0, ECS_INVALID_PARAMETER, NULL);
+
+    return (ecs_meta_sink_t){
+        .action = action,
+        .ctx = ctx,
+        .buf = buf,
+        .size = buf ? size : 0
+    };
+}
+
+int ecs_meta_sink_flush(
+    ecs_meta_sink_t *sink)
+{
+    if (sink->action) {
+        if (sink->count && !sink->failed) {
+            if (sink->action(sink->ctx, sink->buf, sink->count)) {
+                sink->failed = true;
+            }
+        }
+        sink->count = 0;
+    } else {
+        /* Space for the terminator is reserved by appendstrn */
+        sink->buf[sink->count] = '\0';
+    }
+
+    return sink->failed ? -1 : 0;
+}
+
+int ecs_meta_write_file(
+    void *ctx,
+    const char *str,
+    ecs_size_t len)
+{
+    FILE *file = ctx;
+    ecs_assert(file != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (fwrite(str, 1, (size_t)len, file) != (size_t)len) {
+        return -1;
+    }
+
+    return 0;
+}
+
+void ecs_meta_sink_appendstrn(
+    ecs_meta_sink_t *sink,
+    const char *str,
+    ecs_size_t len)
+{
+    if (!len) {
+        return;
+    }
+
+    sink->written += len;
+
+    if (!sink->action) {
+        /* Fixed buffer, reserve one character for the terminator */
+        ecs_size_t space = sink->size - 1 - sink->count;
+        if (len > space) {
+            len = space;
+            sink->overflow = true;
+        }
+        ecs_os_memcpy(&sink->buf[sink->count], str, len);
+        sink->count += len;
+        return;
+    }
+
+    if (sink->failed) {
+        return;
+    }
+
+    if (sink->count + len > sink->size) {
+        /* Output does not fit in buffer, flush. If it does not fit in an empty
+         * buffer either, write it directly. */
+        if (ecs_meta_sink_flush(sink)) {
+            return;
+        }
+
+        if (len > sink->size) {
+            if (sink->action(sink->ctx, str, len)) {
+                sink->failed = true;
+            }
+            return;
+        }
+    }
+
+    ecs_os_memcpy(&sink->buf[sink->count], str, len);
+    sink->count += len;
+}
+
+void ecs_meta_sink_appendstr(
+    ecs_meta_sink_t *sink,
+    const char *str)
+{
+    ecs_meta_sink_appendstrn(sink, str, ecs_os_strlen(str));
+}
+
+void ecs_meta_sink_list_push(
+    ecs_meta_sink_t *sink,
+    const char *prefix,
+    const char *separator)
+{
+    ecs_assert(sink->list_sp < ECS_META_SINK_MAX_DEPTH, 
+        ECS_INVALID_PARAMETER, NULL);
+
+    sink->list_sep[sink->list_sp] = separator;
+    sink->list_count[sink->list_sp] = 0;
+    sink->list_sp ++;
+
+    ecs_meta_sink_appendstr(sink, prefix);
+}
+
+void ecs_meta_sink_list_next(
+    ecs_meta_sink_t *sink)
+{
+    ecs_assert(sink->list_sp > 0, ECS_INVALID_PARAMETER, NULL);
+
+    int32_t sp = sink->list_sp - 1;
+    if (sink->list_count[sp] ++) {
+        ecs_meta_sink_appendstr(sink, sink->list_sep[sp]);
+    }
+}
+
+void ecs_meta_sink_list_appendstr(
+    ecs_meta_sink_t *sink,
+    const char *str)
+{
+    ecs_meta_sink_list_next(sink);
+    ecs_meta_sink_appendstr(sink, str);
+}
+
+void ecs_meta_sink_list_pop(
+    ecs_meta_sink_t *sink,
+    const char *suffix)
+{
+    ecs_assert(sink->list_sp > 0, ECS_INVALID_PARAMETER, NULL);
+
+    sink->list_sp --;
+    ecs_meta_sink_appendstr(sink, suffix);
+}
+
+void ecs_meta_sink_reset(
+    ecs_meta_sink_t *sink)
+{
+    sink->count = 0;
+    sink->list_sp = 0;
+}
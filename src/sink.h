@@ -0,0 +1,38 @@
+#ifndef FLECS_META_SINK_H
+#define FLECS_META_SINK_H
+
+#include "flecs_meta.h"
+
+/* Append functions mirror the ecs_strbuf_t API, so serializers can write to a
+ * sink the same way they would write to a string buffer. */
+
+void ecs_meta_sink_appendstrn(
+    ecs_meta_sink_t *sink,
+    const char *str,
+    ecs_size_t len);
+
+void ecs_meta_sink_appendstr(
+    ecs_meta_sink_t *sink,
+    const char *str);
+
+void ecs_meta_sink_list_push(
+    ecs_meta_sink_t *sink,
+    const char *prefix,
+    const char *separator);
+
+void ecs_meta_sink_list_next(
+    ecs_meta_sink_t *sink);
+
+void ecs_meta_sink_list_appendstr(
+    ecs_meta_sink_t *sink,
+    const char *str);
+
+void ecs_meta_sink_list_pop(
+    ecs_meta_sink_t *sink,
+    const char *suffix);
+
+/* Discard output in buffer, and reset list state */
+void ecs_meta_sink_reset(
+    ecs_meta_sink_t *sink);
+
+#endif
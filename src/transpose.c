@@ -0,0 +1,304 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+
+/* Each leaf member op of a type (a primitive, enum, bitmask or collection) is
+ * transposed to its own array. Nested structs are flattened, so a Line with
+ * two Points becomes four arrays. Values are copied bytewise, which is why
+ * types that own heap memory are not supported. */
+
+#define SOA_MAX_FAST_MEMBERS (4)
+
+typedef struct soa_member_t {
+    int32_t offset;
+    ecs_size_t size;
+} soa_member_t;
+
+static
+bool is_leaf(
+    ecs_type_op_t *op)
+{
+    return op->kind != EcsOpHeader && op->kind != EcsOpPush &&
+        op->kind != EcsOpPop;
+}
+
+static
+int32_t get_members(
+    const EcsMetaTypeSerializer *ser,
+    soa_member_t *members,
+    int32_t max_count)
+{
+    ecs_type_op_t *op = ecs_vector_first(ser->ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ser->ops), result = 0;
+
+    for (i = 0; i < count; i ++) {
+        if (!is_leaf(&op[i])) {
+            continue;
+        }
+
+        if (result < max_count) {
+            members[result] = (soa_member_t){
+                .offset = op[i].offset,
+                .size = op[i].size * op[i].count
+            };
+        }
+
+        result ++;
+    }
+
+    return result;
+}
+
+/* Returns member width if all members have the same width of 4 or 8 bytes
+ * and are laid out back to back without padding, or 0 otherwise */
+static
+ecs_size_t packed_width(
+    soa_member_t *members,
+    int32_t count,
+    ecs_size_t size)
+{
+    if (count < 2 || count > SOA_MAX_FAST_MEMBERS) {
+        return 0;
+    }
+
+    ecs_size_t width = members[0].size;
+    if (width != 4 && width != 8) {
+        return 0;
+    }
+
+    if (width * count != size) {
+        return 0;
+    }
+
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (members[i].size != width || members[i].offset != i * width) {
+            return 0;
+        }
+    }
+
+    return width;
+}
+
+/* Kernels for packed structs. The member count and width are compile time
+ * constants in each instantiation, which lets the compiler turn the loop into
+ * vector loads and shuffles. */
+#define SOA_KERNEL(T, N)\
+static \
+void to_soa_##T##_##N(const T *src, int32_t count, void **dst) {\
+    int32_t i, m;\
+    for (m = 0; m < N; m ++) {\
+        T *out = dst[m];\
+        for (i = 0; i < count; i ++) {\
+            out[i] = src[i * N + m];\
+        }\
+    }\
+}\
+static \
+void from_soa_##T##_##N(T *dst, int32_t count, void * const *src) {\
+    int32_t i, m;\
+    for (m = 0; m < N; m ++) {\
+        const T *in = src[m];\
+        for (i = 0; i < count; i ++) {\
+            dst[i * N + m] = in[i];\
+        }\
+    }\
+}
+
+SOA_KERNEL(uint32_t, 2)
+SOA_KERNEL(uint32_t, 3)
+SOA_KERNEL(uint32_t, 4)
+SOA_KERNEL(uint64_t, 2)
+SOA_KERNEL(uint64_t, 3)
+SOA_KERNEL(uint64_t, 4)
+
+static
+bool to_soa_packed(
+    ecs_size_t width,
+    int32_t member_count,
+    const void *aos,
+    int32_t count,
+    void **soa)
+{
+    switch(width * 8 + member_count) {
+    case 4 * 8 + 2: to_soa_uint32_t_2(aos, count, soa); return true;
+    case 4 * 8 + 3: to_soa_uint32_t_3(aos, count, soa); return true;
+    case 4 * 8 + 4: to_soa_uint32_t_4(aos, count, soa); return true;
+    case 8 * 8 + 2: to_soa_uint64_t_2(aos, count, soa); return true;
+    case 8 * 8 + 3: to_soa_uint64_t_3(aos, count, soa); return true;
+    case 8 * 8 + 4: to_soa_uint64_t_4(aos, count, soa); return true;
+    default: return false;
+    }
+}
+
+static
+bool from_soa_packed(
+    ecs_size_t width,
+    int32_t member_count,
+    void *aos,
+    int32_t count,
+    void * const *soa)
+{
+    switch(width * 8 + member_count) {
+    case 4 * 8 + 2: from_soa_uint32_t_2(aos, count, soa); return true;
+    case 4 * 8 + 3: from_soa_uint32_t_3(aos, count, soa); return true;
+    case 4 * 8 + 4: from_soa_uint32_t_4(aos, count, soa); return true;
+    case 8 * 8 + 2: from_soa_uint64_t_2(aos, count, soa); return true;
+    case 8 * 8 + 3: from_soa_uint64_t_3(aos, count, soa); return true;
+    case 8 * 8 + 4: from_soa_uint64_t_4(aos, count, soa); return true;
+    default: return false;
+    }
+}
+
+/* Strided copy with specializations for common widths, so that the copy in the
+ * inner loop is a single load and store */
+static
+void copy_strided(
+    void *dst,
+    ecs_size_t dst_stride,
+    const void *src,
+    ecs_size_t src_stride,
+    ecs_size_t width,
+    int32_t count)
+{
+    int32_t i;
+    switch(width) {
+    case 1:
+        for (i = 0; i < count; i ++) {
+            memcpy(ECS_OFFSET(dst, i * dst_stride),
+                ECS_OFFSET(src, i * src_stride), 1);
+        }
+        break;
+    case 2:
+        for (i = 0; i < count; i ++) {
+            memcpy(ECS_OFFSET(dst, i * dst_stride),
+                ECS_OFFSET(src, i * src_stride), 2);
+        }
+        break;
+    case 4:
+        for (i = 0; i < count; i ++) {
+            memcpy(ECS_OFFSET(dst, i * dst_stride),
+                ECS_OFFSET(src, i * src_stride), 4);
+        }
+        break;
+    case 8:
+        for (i = 0; i < count; i ++) {
+            memcpy(ECS_OFFSET(dst, i * dst_stride),
+                ECS_OFFSET(src, i * src_stride), 8);
+        }
+        break;
+    default:
+        for (i = 0; i < count; i ++) {
+            memcpy(ECS_OFFSET(dst, i * dst_stride),
+                ECS_OFFSET(src, i * src_stride), (size_t)width);
+        }
+        break;
+    }
+}
+
+int32_t ecs_meta_soa_layout(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    ecs_size_t *sizes,
+    int32_t max_count)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    if (ser->owns_heap) {
+        return -1;
+    }
+
+    ecs_type_op_t *op = ecs_vector_first(ser->ops, ecs_type_op_t);
+    int32_t i, count = ecs_vector_count(ser->ops), result = 0;
+
+    for (i = 0; i < count; i ++) {
+        if (!is_leaf(&op[i])) {
+            continue;
+        }
+
+        if (sizes && result < max_count) {
+            sizes[result] = op[i].size * op[i].count;
+        }
+
+        result ++;
+    }
+
+    return result;
+}
+
+int ecs_meta_transpose_to_soa(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const void *aos,
+    int32_t count,
+    void **soa)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    if (ser->owns_heap) {
+        return -1;
+    }
+
+    ecs_type_op_t *hdr = ecs_vector_first(ser->ops, ecs_type_op_t);
+    ecs_size_t size = hdr->size;
+
+    soa_member_t fast[SOA_MAX_FAST_MEMBERS];
+    int32_t i, member_count = get_members(ser, fast, SOA_MAX_FAST_MEMBERS);
+
+    if (member_count <= SOA_MAX_FAST_MEMBERS) {
+        ecs_size_t width = packed_width(fast, member_count, size);
+        if (width && to_soa_packed(width, member_count, aos, count, soa)) {
+            return 0;
+        }
+    }
+
+    soa_member_t *members = ecs_os_malloc(
+        ECS_SIZEOF(soa_member_t) * member_count);
+    get_members(ser, members, member_count);
+
+    for (i = 0; i < member_count; i ++) {
+        copy_strided(soa[i], members[i].size,
+            ECS_OFFSET(aos, members[i].offset), size,
+            members[i].size, count);
+    }
+
+    ecs_os_free(members);
+
+    return 0;
+}
+
+int ecs_meta_transpose_from_soa(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *aos,
+    int32_t count,
+    void * const *soa)
+{
+    const EcsMetaTypeSerializer *ser = ecs_meta_type_serializer(world, type);
+    if (ser->owns_heap) {
+        return -1;
+    }
+
+    ecs_type_op_t *hdr = ecs_vector_first(ser->ops, ecs_type_op_t);
+    ecs_size_t size = hdr->size;
+
+    soa_member_t fast[SOA_MAX_FAST_MEMBERS];
+    int32_t i, member_count = get_members(ser, fast, SOA_MAX_FAST_MEMBERS);
+
+    if (member_count <= SOA_MAX_FAST_MEMBERS) {
+        ecs_size_t width = packed_width(fast, member_count, size);
+        if (width && from_soa_packed(width, member_count, aos, count, soa)) {
+            return 0;
+        }
+    }
+
+    soa_member_t *members = ecs_os_malloc(
+        ECS_SIZEOF(soa_member_t) * member_count);
+    get_members(ser, members, member_count);
+
+    for (i = 0; i < member_count; i ++) {
+        copy_strided(ECS_OFFSET(aos, members[i].offset), size,
+            soa[i], members[i].size, members[i].size, count);
+    }
+
+    ecs_os_free(members);
+
+    return 0;
+}
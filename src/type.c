@@ -1,4 +1,65 @@
 #include "type.h"
+#include "world.h"
+#include <ctype.h>
+
+/* Lookup type by token. The token is copied to a buffer on the stack, unless
+ * it is longer than ECS_META_IDENTIFIER_LENGTH. */
+static
+ecs_entity_t lookup_symbol(
+    ecs_world_t *world,
+    const ecs_meta_token_t *token)
+{
+    char buf[ECS_META_IDENTIFIER_LENGTH];
+    char *name = buf;
+
+    if (token->len >= ECS_META_IDENTIFIER_LENGTH) {
+        name = ecs_os_malloc(token->len + 1);
+    }
+
+    ecs_os_memcpy(name, token->ptr, token->len);
+    name[token->len] = '\0';
+
+    ecs_entity_t result = ecs_lookup_symbol(world, name);
+
+    if (name != buf) {
+        ecs_os_free(name);
+    }
+
+    return result;
+}
+
+/* Get anonymous array type. Arrays with the same element type and count share
+ * a single entity, so they also share a serializer. */
+static
+ecs_entity_t new_array(
+    ecs_world_t *world,
+    ecs_entity_t element_type,
+    int32_t count)
+{
+    ecs_entity_t result = ecs_meta_find_interned(
+        world, EcsArrayType, 0, element_type, count);
+    if (result) {
+        return result;
+    }
+
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
+    const EcsMetaType *elem_type = ecs_get(world, element_type, EcsMetaType);
+    ecs_assert(elem_type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_assert((int64_t)elem_type->size * count <= INT32_MAX, 
+        ECS_INVALID_PARAMETER, NULL);
+
+    result = ecs_set(world, 0, EcsMetaType, {
+        EcsArrayType, elem_type->size * count, elem_type->alignment, NULL, NULL
+    });
+
+    ecs_meta_intern(world, EcsArrayType, 0, element_type, count, result);
+
+    return ecs_set(world, result, EcsArray, { element_type, count });
+}
 
 ecs_entity_t ecs_meta_lookup_array(
     ecs_world_t *world,
@@ -6,6 +67,10 @@ ecs_entity_t ecs_meta_lookup_array(
     const char *params_decl,
     ecs_meta_parse_ctx_t *ctx)
 {    
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
     ecs_meta_parse_ctx_t param_ctx = {
         .name = ctx->name,
         .decl = params_decl
@@ -21,34 +86,20 @@ ecs_entity_t ecs_meta_lookup_array(
         ecs_meta_error(ctx, params_decl, "invalid array size");
     }
 
-    ecs_entity_t element_type = ecs_lookup_symbol(world, params.type.type);
+    ecs_entity_t element_type = lookup_symbol(world, &params.type.type);
     if (!element_type) {
-        ecs_meta_error(ctx, params_decl, "unknown element type '%s'", 
-            params.type.type);
+        ecs_meta_error(ctx, params_decl, "unknown element type '%.*s'", 
+            params.type.type.len, params.type.type.ptr);
     }
 
-    if (!e) {
-        ecs_entity_t ecs_entity(EcsMetaType) = ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-        ecs_assert(ecs_entity(EcsMetaType) != 0, ECS_INTERNAL_ERROR, NULL);
-
-        const EcsMetaType *elem_type = ecs_get(world, element_type, EcsMetaType);
-        ecs_assert(elem_type != NULL, ECS_INTERNAL_ERROR, NULL);
-
-        ecs_assert(elem_type->size * params.count <= INT32_MAX, 
-            ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(params.count <= INT32_MAX, ECS_INVALID_PARAMETER, NULL);
 
-        e = ecs_set(world, 0, EcsMetaType, {
-            EcsArrayType, (int32_t)(elem_type->size * params.count), 
-            elem_type->alignment, NULL, NULL
-        });
+    if (e) {
+        return ecs_set(world, e, EcsArray, { 
+            element_type, (int32_t)params.count });
     }
 
-    ecs_entity_t ecs_entity(EcsArray) = ecs_lookup_fullpath(world, "flecs.meta.Array");
-    ecs_assert(ecs_entity(EcsArray) != 0, ECS_INTERNAL_ERROR, NULL);
-
-    ecs_assert(params.count <= INT32_MAX, ECS_INVALID_PARAMETER, NULL);
-
-    return ecs_set(world, e, EcsArray, { element_type, (int32_t)params.count });
+    return new_array(world, element_type, (int32_t)params.count);
 }
 
 ecs_entity_t ecs_meta_lookup_vector(
@@ -57,6 +108,10 @@ ecs_entity_t ecs_meta_lookup_vector(
     const char *params_decl,
     ecs_meta_parse_ctx_t *ctx)
 {    
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
     ecs_meta_parse_ctx_t param_ctx = {
         .name = ctx->name,
         .decl = params_decl
@@ -73,15 +128,15 @@ ecs_entity_t ecs_meta_lookup_vector(
         world, &params.type, params_decl, 1, &param_ctx);
 
     if (!e) {
-        ecs_entity_t ecs_entity(EcsMetaType) = ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-        ecs_assert(ecs_entity(EcsMetaType) != 0, ECS_INTERNAL_ERROR, NULL);
+        e = ecs_meta_find_interned(world, EcsVectorType, 0, element_type, 0);
+        if (e) {
+            return e;
+        }
 
         e = ecs_set(world, 0, EcsMetaType, {EcsVectorType, 0, 0, NULL, NULL});
+        ecs_meta_intern(world, EcsVectorType, 0, element_type, 0, e);
     }
 
-    ecs_entity_t ecs_entity(EcsVector) = ecs_lookup_fullpath(world, "flecs.meta.Vector");
-    ecs_assert(ecs_entity(EcsVector) != 0, ECS_INTERNAL_ERROR, NULL);
-
     return ecs_set(world, e, EcsVector, { element_type });
 }
 
@@ -91,6 +146,10 @@ ecs_entity_t ecs_meta_lookup_map(
     const char *params_decl,
     ecs_meta_parse_ctx_t *ctx)
 {    
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
     ecs_meta_parse_ctx_t param_ctx = {
         .name = ctx->name,
         .decl = params_decl
@@ -110,15 +169,16 @@ ecs_entity_t ecs_meta_lookup_map(
         world, &params.type, params_decl, 1, &param_ctx);
     
     if (!e) {
-        ecs_entity_t ecs_entity(EcsMetaType) = ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-        ecs_assert(ecs_entity(EcsMetaType) != 0, ECS_INTERNAL_ERROR, NULL);
-        
+        e = ecs_meta_find_interned(
+            world, EcsMapType, key_type, element_type, 0);
+        if (e) {
+            return e;
+        }
+
         e = ecs_set(world, 0, EcsMetaType, {EcsMapType, 0, 0, NULL, NULL});
+        ecs_meta_intern(world, EcsMapType, key_type, element_type, 0, e);
     }
 
-    ecs_entity_t ecs_entity(EcsMap) = ecs_lookup_fullpath(world, "flecs.meta.Map");
-    ecs_assert(ecs_entity(EcsMap) != 0, ECS_INTERNAL_ERROR, NULL);
-
     return ecs_set(world, e, EcsMap, { key_type, element_type });
 }
 
@@ -130,6 +190,10 @@ ecs_entity_t ecs_meta_lookup_bitmask(
 {
     (void)e;
 
+    FlecsMeta storage;
+    const FlecsMeta *module = ecs_meta_get_module(world, &storage);
+    FlecsMetaImportHandles(*module);
+
     ecs_meta_parse_ctx_t param_ctx = {
         .name = ctx->name,
         .decl = params_decl
@@ -152,9 +216,6 @@ ecs_entity_t ecs_meta_lookup_bitmask(
     ecs_assert(bitmask_type != 0, ECS_INVALID_PARAMETER, NULL);
 
     /* Make sure this is a bitmask type */
-    ecs_entity_t ecs_entity(EcsMetaType) = ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-    ecs_assert(ecs_entity(EcsMetaType) != 0, ECS_INTERNAL_ERROR, NULL);
-
     const EcsMetaType *type_ptr = ecs_get(world, bitmask_type, EcsMetaType);
     ecs_assert(type_ptr != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(type_ptr->kind == EcsBitmaskType, ECS_INVALID_PARAMETER, NULL);
@@ -174,57 +235,394 @@ ecs_entity_t ecs_meta_lookup(
     ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(ctx != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    const char *typename = token->type;
+    const ecs_meta_token_t *typename = &token->type;
+    const char *params = token->params.ptr;
+    if (!params) {
+        /* Missing parameters are reported by the collection parser */
+        params = typename->ptr + typename->len;
+    }
     ecs_entity_t type = 0;
 
     /* Parse vector type */
-    if (!strcmp(typename, "ecs_array")) {
-        type = ecs_meta_lookup_array(world, 0, token->params, ctx);
+    if (ecs_meta_token_eq(typename, "ecs_array")) {
+        type = ecs_meta_lookup_array(world, 0, params, ctx);
 
-    } else if (!strcmp(typename, "ecs_vector") || !strcmp(typename, "flecs::vector")) {
-        type = ecs_meta_lookup_vector(world, 0, token->params, ctx);
+    } else if (ecs_meta_token_eq(typename, "ecs_vector") || 
+        ecs_meta_token_eq(typename, "flecs::vector")) 
+    {
+        type = ecs_meta_lookup_vector(world, 0, params, ctx);
 
-    } else if (!strcmp(typename, "ecs_map") | !strcmp(typename, "flecs::map")) {
-        type = ecs_meta_lookup_map(world, 0, token->params, ctx);
+    } else if (ecs_meta_token_eq(typename, "ecs_map") || 
+        ecs_meta_token_eq(typename, "flecs::map")) 
+    {
+        type = ecs_meta_lookup_map(world, 0, params, ctx);
 
-    } else if (!strcmp(typename, "flecs::bitmask")) {
-        type = ecs_meta_lookup_bitmask(world, 0, token->params, ctx);
+    } else if (ecs_meta_token_eq(typename, "flecs::bitmask")) {
+        type = ecs_meta_lookup_bitmask(world, 0, params, ctx);
 
-    } else if (!strcmp(typename, "flecs::byte")) {
+    } else if (ecs_meta_token_eq(typename, "flecs::byte")) {
         type = ecs_lookup(world, "ecs_byte_t");
 
     } else {
-        if (token->is_ptr && !strcmp(typename, "char")) {
-            typename = "ecs_string_t";
+        const char *alias = NULL;
+
+        if (token->is_ptr && ecs_meta_token_eq(typename, "char")) {
+            alias = "ecs_string_t";
         } else
         if (token->is_ptr) {
-            typename = "uintptr_t";
+            alias = "uintptr_t";
         } else        
-        if (!strcmp(typename, "char*") || !strcmp(typename, "flecs::string")) {
-            typename = "ecs_string_t";
+        if (ecs_meta_token_eq(typename, "char*") || 
+            ecs_meta_token_eq(typename, "flecs::string")) 
+        {
+            alias = "ecs_string_t";
+        }
+
+        if (alias) {
+            type = ecs_lookup_symbol(world, alias);
+        } else {
+            type = lookup_symbol(world, typename);
         }
 
-        type = ecs_lookup_symbol(world, typename);
         if (!type) {
-            ecs_meta_error(ctx, ptr, "unknown type '%s'", typename);
+            if (alias) {
+                ecs_meta_error(ctx, ptr, "unknown type '%s'", alias);
+            } else {
+                ecs_meta_error(ctx, ptr, "unknown type '%.*s'", 
+                    typename->len, typename->ptr);
+            }
             return 0;
         }
     }
 
     if (count != 1) {
-        /* If count is not 1, insert array type. First lookup EcsMetaType of the
-         * element type to get the size and alignment. Then create a new
-         * entity for the array type, and assign it to the member type. */
-        ecs_entity_t ecs_entity(EcsMetaType) = ecs_lookup_fullpath(world, "flecs.meta.MetaType");
-        ecs_entity_t ecs_entity(EcsArray) = ecs_lookup_fullpath(world, "flecs.meta.Array");
-        const EcsMetaType *type_ptr = ecs_get(world, type, EcsMetaType);
-
+        /* If count is not 1, use array type as member type */
         ecs_assert(count <= INT32_MAX, ECS_INVALID_PARAMETER, NULL);
-
-        type = ecs_set(world, ecs_set(world, 0, 
-            EcsMetaType, {EcsArrayType, type_ptr->size, type_ptr->alignment, NULL, NULL}),
-            EcsArray, {type, (int32_t)count});
+        type = new_array(world, type, (int32_t)count);
     }
 
     return type;
 }
+
+bool ecs_meta_type_equal(
+    const EcsMetaType *a,
+    const EcsMetaType *b)
+{
+    if (a->kind != b->kind) {
+        return false;
+    }
+
+    if (a->size != b->size || a->alignment != b->alignment) {
+        return false;
+    }
+
+    if (!a->descriptor || !b->descriptor) {
+        return a->descriptor == b->descriptor;
+    }
+
+    return !strcmp(a->descriptor, b->descriptor);
+}
+
+uint64_t ecs_meta_hash_name(
+    const char *name,
+    ecs_size_t len)
+{
+    /* FNV-1a */
+    uint64_t hash = 14695981039346656037ull;
+    ecs_size_t i;
+    for (i = 0; i < len; i ++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+void ecs_meta_enum_fini(
+    EcsEnum *type)
+{
+    ecs_vector_free(type->names);
+    ecs_map_free(type->values);
+    type->names = NULL;
+    type->values = NULL;
+    type->min_value = 0;
+}
+
+void ecs_meta_enum_init(
+    EcsEnum *type)
+{
+    ecs_meta_enum_fini(type);
+
+    int32_t count = ecs_map_count(type->constants);
+    if (!count) {
+        return;
+    }
+
+    type->values = ecs_map_new(int32_t, count);
+
+    int32_t min = INT32_MAX, max = INT32_MIN;
+    ecs_map_key_t key;
+    char **name;
+
+    ecs_map_iter_t it = ecs_map_iter(type->constants);
+    while ((name = ecs_map_next(&it, char*, &key))) {
+        int32_t value = (int32_t)key;
+        if (value < min) {
+            min = value;
+        }
+        if (value > max) {
+            max = value;
+        }
+
+        uint64_t hash = ecs_meta_hash_name(*name, ecs_os_strlen(*name));
+        ecs_map_set(type->values, hash, &value);
+    }
+
+    /* Only use a names table if at least half of its elements are used */
+    int64_t range = (int64_t)max - min + 1;
+    if (range > (int64_t)count * 2) {
+        return;
+    }
+
+    type->min_value = min;
+    ecs_vector_set_count(&type->names, char*, (int32_t)range);
+    char **names = ecs_vector_first(type->names, char*);
+    memset(names, 0, sizeof(char*) * (size_t)range);
+
+    it = ecs_map_iter(type->constants);
+    while ((name = ecs_map_next(&it, char*, &key))) {
+        names[(int32_t)key - min] = *name;
+    }
+}
+
+const char* ecs_meta_enum_name(
+    const EcsEnum *type,
+    int32_t value)
+{
+    if (type->names) {
+        int64_t index = (int64_t)value - type->min_value;
+        if (index < 0 || index >= ecs_vector_count(type->names)) {
+            return NULL;
+        }
+
+        return ecs_vector_first(type->names, char*)[index];
+    }
+
+    char **constant = ecs_map_get(type->constants, char*, value);
+    if (!constant) {
+        return NULL;
+    }
+
+    return *constant;
+}
+
+int ecs_meta_enum_value(
+    const EcsEnum *type,
+    const char *name,
+    int32_t *value_out)
+{
+    if (type->values) {
+        int32_t *value = ecs_map_get(type->values, int32_t, 
+            ecs_meta_hash_name(name, ecs_os_strlen(name)));
+        if (value) {
+            const char *constant = ecs_meta_enum_name(type, *value);
+            if (constant && !strcmp(constant, name)) {
+                *value_out = *value;
+                return 0;
+            }
+        }
+    }
+
+    /* Names with the same hash, or tables that have not been built */
+    ecs_map_key_t key;
+    char **constant;
+    ecs_map_iter_t it = ecs_map_iter(type->constants);
+    while ((constant = ecs_map_next(&it, char*, &key))) {
+        if (!strcmp(*constant, name)) {
+            *value_out = (int32_t)key;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static
+int32_t count_bits(
+    uint32_t value)
+{
+    int32_t result = 0;
+    for (; value; value &= value - 1) {
+        result ++;
+    }
+
+    return result;
+}
+
+static
+int compare_compounds(
+    const void *ptr1,
+    const void *ptr2)
+{
+    const ecs_meta_bitmask_constant_t *c1 = ptr1;
+    const ecs_meta_bitmask_constant_t *c2 = ptr2;
+    int32_t bits1 = count_bits(c1->value), bits2 = count_bits(c2->value);
+    if (bits1 != bits2) {
+        return bits2 - bits1;
+    }
+
+    return (c1->value > c2->value) - (c1->value < c2->value);
+}
+
+void ecs_meta_bitmask_fini(
+    EcsBitmask *type)
+{
+    ecs_vector_free(type->bits);
+    ecs_vector_free(type->compounds);
+    ecs_map_free(type->values);
+    type->bits = NULL;
+    type->compounds = NULL;
+    type->values = NULL;
+}
+
+void ecs_meta_bitmask_init(
+    EcsBitmask *type)
+{
+    ecs_meta_bitmask_fini(type);
+
+    int32_t count = ecs_map_count(type->constants);
+    if (!count) {
+        return;
+    }
+
+    type->values = ecs_map_new(uint32_t, count);
+
+    ecs_map_key_t key;
+    char **name;
+    ecs_map_iter_t it = ecs_map_iter(type->constants);
+    while ((name = ecs_map_next(&it, char*, &key))) {
+        uint32_t value = (uint32_t)key;
+        uint64_t hash = ecs_meta_hash_name(*name, ecs_os_strlen(*name));
+        ecs_map_set(type->values, hash, &value);
+
+        /* Constants without bits are only used for values that are 0 */
+        if (!value) {
+            continue;
+        }
+
+        if (!(value & (value - 1))) {
+            if (!type->bits) {
+                ecs_vector_set_count(&type->bits, char*, 32);
+                memset(ecs_vector_first(type->bits, char*), 0, 
+                    sizeof(char*) * 32);
+            }
+
+            /* Bits below the single bit of value are the bits of value - 1 */
+            ecs_vector_first(type->bits, char*)[count_bits(value - 1)] = *name;
+        } else {
+            ecs_meta_bitmask_constant_t *c = ecs_vector_add(
+                &type->compounds, ecs_meta_bitmask_constant_t);
+            c->value = value;
+            c->name = *name;
+        }
+    }
+
+    /* Match constants that cover the most bits first */
+    if (type->compounds) {
+        qsort(ecs_vector_first(type->compounds, ecs_meta_bitmask_constant_t),
+            (size_t)ecs_vector_count(type->compounds),
+            sizeof(ecs_meta_bitmask_constant_t), compare_compounds);
+    }
+}
+
+static
+int bitmask_constant(
+    const EcsBitmask *type,
+    const char *name,
+    ecs_size_t len,
+    uint32_t *value_out)
+{
+    if (type->values) {
+        uint32_t *value = ecs_map_get(type->values, uint32_t, 
+            ecs_meta_hash_name(name, len));
+        if (value) {
+            char **constant = ecs_map_get(
+                type->constants, char*, (ecs_map_key_t)*value);
+            if (constant && !strncmp(*constant, name, (size_t)len) && 
+                !(*constant)[len]) 
+            {
+                *value_out = *value;
+                return 0;
+            }
+        }
+    }
+
+    /* Names with the same hash, or tables that have not been built */
+    ecs_map_key_t key;
+    char **constant;
+    ecs_map_iter_t it = ecs_map_iter(type->constants);
+    while ((constant = ecs_map_next(&it, char*, &key))) {
+        if (!strncmp(*constant, name, (size_t)len) && !(*constant)[len]) {
+            *value_out = (uint32_t)key;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int ecs_meta_bitmask_value(
+    const EcsBitmask *type,
+    const char *expr,
+    uint32_t *value_out)
+{
+    uint32_t result = 0;
+    const char *ptr = expr;
+
+    for (;;) {
+        while (isspace((unsigned char)*ptr)) {
+            ptr ++;
+        }
+
+        const char *start = ptr;
+        while (*ptr && *ptr != '|' && !isspace((unsigned char)*ptr)) {
+            ptr ++;
+        }
+
+        ecs_size_t len = (ecs_size_t)(ptr - start);
+        if (!len) {
+            return -1;
+        }
+
+        uint32_t value;
+        if (isdigit((unsigned char)*start)) {
+            char *end;
+            value = (uint32_t)strtoul(start, &end, 0);
+            if (end != ptr) {
+                return -1;
+            }
+        } else if (bitmask_constant(type, start, len, &value)) {
+            return -1;
+        }
+
+        result |= value;
+
+        while (isspace((unsigned char)*ptr)) {
+            ptr ++;
+        }
+
+        if (*ptr != '|') {
+            break;
+        }
+
+        ptr ++;
+    }
+
+    if (*ptr) {
+        return -1;
+    }
+
+    *value_out = result;
+
+    return 0;
+}
@@ -28,4 +28,55 @@ ecs_entity_t ecs_meta_lookup(
     int64_t count,
     ecs_meta_parse_ctx_t *ctx);
 
+/* Test if two type definitions are the same */
+bool ecs_meta_type_equal(
+    const EcsMetaType *a,
+    const EcsMetaType *b);
+
+/* Hash of a name that is not necessarily 0-terminated (FNV-1a) */
+uint64_t ecs_meta_hash_name(
+    const char *name,
+    ecs_size_t len);
+
+/* Build lookup tables of an enum type from its constants */
+void ecs_meta_enum_init(
+    EcsEnum *type);
+
+/* Free lookup tables of an enum type */
+void ecs_meta_enum_fini(
+    EcsEnum *type);
+
+/* Get name of enum constant, or NULL if there is no constant for value */
+const char* ecs_meta_enum_name(
+    const EcsEnum *type,
+    int32_t value);
+
+/* Get value of enum constant by name. Returns -1 if there is no constant */
+int ecs_meta_enum_value(
+    const EcsEnum *type,
+    const char *name,
+    int32_t *value_out);
+
+/* Constant of a bitmask type with multiple bits */
+typedef struct ecs_meta_bitmask_constant_t {
+    uint32_t value;
+    char *name;
+} ecs_meta_bitmask_constant_t;
+
+/* Build lookup tables of a bitmask type from its constants */
+void ecs_meta_bitmask_init(
+    EcsBitmask *type);
+
+/* Free lookup tables of a bitmask type */
+void ecs_meta_bitmask_fini(
+    EcsBitmask *type);
+
+/* Parse expression with bitmask constants, like "Bacon | Lettuce". Numbers
+ * are accepted in place of constants. Returns -1 if the expression is not
+ * valid. */
+int ecs_meta_bitmask_value(
+    const EcsBitmask *type,
+    const char *expr,
+    uint32_t *value_out);
+
 #endif
@@ -0,0 +1,1086 @@
+#include <flecs_meta.h>
+#include <ctype.h>
+#include <locale.h>
+#include <math.h>
+#include "parser.h"
+
+/* Parser for values in the format of the pretty printer. The parser walks the
+ * type ops with a cursor, so the type decides what is expected next, and the
+ * input is read in a single pass. Input is bounded by an end pointer instead of
+ * a 0-terminator, so that values can be parsed from chunks of a stream. */
+
+typedef struct str_parser_t {
+    ecs_meta_cursor_t *cursor;
+    const char *name;    /* Name used in errors */
+    const char *expr;    /* Start of input */
+    const char *end;     /* End of input */
+    int64_t offset;      /* Offset of input in stream, -1 if not a stream */
+} str_parser_t;
+
+static
+const char* str_parse_value(
+    str_parser_t *p,
+    const char *ptr);
+
+static
+void str_error(
+    str_parser_t *p,
+    const char *ptr,
+    const char *fmt,
+    ...)
+{
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+
+    if (p->offset == -1) {
+        const char *line_start = p->expr, *cur;
+        int32_t line = 1;
+        for (cur = p->expr; cur < ptr; cur ++) {
+            if (*cur == '\n') {
+                line_start = cur + 1;
+                line ++;
+            }
+        }
+
+        ecs_strbuf_append(&buf, "%s:%d:%d: error: ", p->name, line,
+            (int)(ptr - line_start) + 1);
+    } else {
+        ecs_strbuf_append(&buf, "%s: offset %lld: error: ", p->name,
+            (long long)(p->offset + (ptr - p->expr)));
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    ecs_strbuf_vappend(&buf, fmt, args);
+    va_end(args);
+
+    char *msg = ecs_strbuf_get(&buf);
+    ecs_os_err("%s", msg);
+    ecs_os_free(msg);
+}
+
+static
+const char* str_skip_ws(
+    str_parser_t *p,
+    const char *ptr)
+{
+    while (ptr < p->end && isspace((unsigned char)*ptr)) {
+        ptr ++;
+    }
+
+    return ptr;
+}
+
+static
+bool str_is_ident(
+    char ch)
+{
+    return isalnum((unsigned char)ch) || ch == '_' || ch == '.';
+}
+
+static
+const char* str_ident_end(
+    str_parser_t *p,
+    const char *ptr)
+{
+    while (ptr < p->end && str_is_ident(*ptr)) {
+        ptr ++;
+    }
+
+    return ptr;
+}
+
+static
+bool str_token_eq(
+    const char *start,
+    const char *end,
+    const char *str)
+{
+    ecs_size_t len = (ecs_size_t)(end - start);
+    return !ecs_os_strncmp(start, str, len) && !str[len];
+}
+
+/* Copy token to a 0-terminated buffer. Tokens that don't fit in the buffer are
+ * copied to the heap. */
+static
+char* str_token(
+    char *buf,
+    const char *start,
+    const char *end)
+{
+    ecs_size_t len = (ecs_size_t)(end - start);
+    char *result = buf;
+    if (len >= ECS_META_IDENTIFIER_LENGTH) {
+        result = ecs_os_malloc(len + 1);
+    }
+
+    ecs_os_memcpy(result, start, len);
+    result[len] = '\0';
+    return result;
+}
+
+static
+void str_token_free(
+    char *buf,
+    char *token)
+{
+    if (token != buf) {
+        ecs_os_free(token);
+    }
+}
+
+/* strtod uses the decimal point of the current locale. Number tokens only
+ * contain ASCII digits, signs, exponents and a '.', so replacing the '.' with
+ * the decimal point of the locale parses them the same in any locale. */
+static
+double str_strtod(
+    char *token)
+{
+    const char *point = localeconv()->decimal_point;
+    char *dot = strchr(token, '.');
+    if (!dot || !point[0] || (point[0] == '.' && !point[1])) {
+        return strtod(token, NULL);
+    }
+
+    if (!point[1]) {
+        *dot = point[0];
+        return strtod(token, NULL);
+    }
+
+    /* Multibyte decimal point */
+    ecs_size_t len = ecs_os_strlen(token), point_len = ecs_os_strlen(point);
+    char *str = ecs_os_malloc(len + point_len);
+    ecs_size_t before = (ecs_size_t)(dot - token);
+    ecs_os_memcpy(str, token, before);
+    ecs_os_memcpy(str + before, point, point_len);
+    ecs_os_memcpy(str + before + point_len, dot + 1, len - before);
+    double result = strtod(str, NULL);
+    ecs_os_free(str);
+    return result;
+}
+
+/* Parse unsigned decimal or hexadecimal integer */
+static
+const char* str_parse_u64(
+    str_parser_t *p,
+    const char *ptr,
+    uint64_t *value_out)
+{
+    const char *start;
+    uint64_t value = 0;
+
+    if ((p->end - ptr) > 2 && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X')) {
+        for (start = ptr += 2; ptr < p->end && isxdigit((unsigned char)*ptr); ptr ++) {
+            char ch = *ptr;
+            uint64_t digit = (uint64_t)(isdigit((unsigned char)ch)
+                ? ch - '0' : (tolower((unsigned char)ch) - 'a' + 10));
+            if (value >> 60) {
+                return NULL;
+            }
+            value = (value << 4) | digit;
+        }
+    } else {
+        for (start = ptr; ptr < p->end && isdigit((unsigned char)*ptr); ptr ++) {
+            uint64_t digit = (uint64_t)(*ptr - '0');
+            if (value > (UINT64_MAX - digit) / 10) {
+                return NULL;
+            }
+            value = value * 10 + digit;
+        }
+    }
+
+    if (ptr == start) {
+        return NULL;
+    }
+
+    *value_out = value;
+    return ptr;
+}
+
+static
+const char* str_parse_i64(
+    str_parser_t *p,
+    const char *ptr,
+    int64_t *value_out)
+{
+    bool negative = false;
+    if (ptr < p->end && *ptr == '-') {
+        negative = true;
+        ptr ++;
+    }
+
+    uint64_t value;
+    if (!(ptr = str_parse_u64(p, ptr, &value))) {
+        return NULL;
+    }
+
+    if (negative) {
+        if (value > (uint64_t)INT64_MAX + 1) {
+            return NULL;
+        }
+        *value_out = (int64_t)(0 - value);
+    } else {
+        if (value > INT64_MAX) {
+            return NULL;
+        }
+        *value_out = (int64_t)value;
+    }
+
+    return ptr;
+}
+
+/* Powers of 10 that are exactly representable as double */
+static const double str_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+    1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Parse floating point number. Numbers with a mantissa of at most 53 bits and
+ * a small exponent are converted with a single multiplication or division,
+ * which is exact (Clinger's fast path). Other numbers use strtod. */
+static
+const char* str_parse_f64(
+    str_parser_t *p,
+    const char *ptr,
+    double *value_out)
+{
+    const char *start = ptr;
+    bool negative = false;
+
+    if (ptr < p->end && (*ptr == '-' || *ptr == '+')) {
+        negative = *ptr == '-';
+        ptr ++;
+    }
+
+    if (ptr < p->end && isalpha((unsigned char)*ptr)) {
+        const char *end = str_ident_end(p, ptr);
+        double value;
+        if (str_token_eq(ptr, end, "nan")) {
+            value = (double)NAN;
+        } else if (str_token_eq(ptr, end, "inf")) {
+            value = (double)INFINITY;
+        } else {
+            return NULL;
+        }
+
+        *value_out = negative ? -value : value;
+        return end;
+    }
+
+    uint64_t mantissa = 0;
+    int32_t digits = 0, exponent = 0;
+    bool has_digits = false, truncated = false;
+
+    for (; ptr < p->end && isdigit((unsigned char)*ptr); ptr ++) {
+        has_digits = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*ptr - '0');
+            digits += mantissa != 0;
+        } else {
+            exponent ++;
+            truncated = true;
+        }
+    }
+
+    if (ptr < p->end && *ptr == '.') {
+        for (ptr ++; ptr < p->end && isdigit((unsigned char)*ptr); ptr ++) {
+            has_digits = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*ptr - '0');
+                digits += mantissa != 0;
+                exponent --;
+            } else {
+                truncated = true;
+            }
+        }
+    }
+
+    if (!has_digits) {
+        return NULL;
+    }
+
+    if (ptr < p->end && (*ptr == 'e' || *ptr == 'E')) {
+        int64_t exp;
+        const char *exp_ptr = ptr + 1;
+        if (exp_ptr < p->end && *exp_ptr == '+') {
+            exp_ptr ++;
+        }
+
+        if (!(ptr = str_parse_i64(p, exp_ptr, &exp))) {
+            return NULL;
+        }
+
+        if (exp > 10000 || exp < -10000) {
+            truncated = true;
+        } else {
+            exponent += (int32_t)exp;
+        }
+    }
+
+    if (!truncated && mantissa <= (1ull << 53) &&
+        exponent >= -22 && exponent <= 22)
+    {
+        double value = (double)mantissa;
+        if (exponent < 0) {
+            value /= str_pow10[-exponent];
+        } else {
+            value *= str_pow10[exponent];
+        }
+
+        *value_out = negative ? -value : value;
+    } else {
+        char buf[ECS_META_IDENTIFIER_LENGTH];
+        char *token = str_token(buf, start, ptr);
+        *value_out = str_strtod(token);
+        str_token_free(buf, token);
+    }
+
+    return ptr;
+}
+
+/* Parse character of a string or character literal */
+static
+const char* str_parse_char(
+    str_parser_t *p,
+    const char *ptr,
+    char *ch_out)
+{
+    if (ptr[0] == '\\') {
+        if ((ptr + 1) >= p->end) {
+            return NULL;
+        }
+
+        /* ecs_chrparse does not unescape single quotes */
+        if (ptr[1] == '\'') {
+            *ch_out = '\'';
+            return ptr + 2;
+        }
+    }
+
+    return ecs_chrparse(ptr, ch_out);
+}
+
+static
+const char* str_parse_string(
+    str_parser_t *p,
+    const char *ptr)
+{
+    ecs_meta_cursor_t *cursor = p->cursor;
+    const char *start = ptr;
+
+    if (*ptr != '"') {
+        const char *end = str_ident_end(p, ptr);
+        if (!str_token_eq(ptr, end, "nullptr")) {
+            str_error(p, ptr, "expected string");
+            return NULL;
+        }
+
+        ecs_meta_set_string(cursor, NULL);
+        return end;
+    }
+
+    /* Find closing quote, so the unescaped string can be allocated at once */
+    const char *last;
+    for (last = ptr + 1; last < p->end && *last != '"'; last ++) {
+        if (*last == '\\') {
+            last ++;
+        }
+    }
+
+    if (last >= p->end) {
+        str_error(p, start, "missing '\"' at end of string");
+        return NULL;
+    }
+
+    char buf[ECS_META_IDENTIFIER_LENGTH];
+    char *str = buf;
+    ecs_size_t max_len = (ecs_size_t)(last - ptr);
+    if (max_len >= ECS_META_IDENTIFIER_LENGTH) {
+        str = ecs_os_malloc(max_len + 1);
+    }
+
+    char *out = str;
+    for (ptr ++; ptr < last; out ++) {
+        if (!(ptr = str_parse_char(p, ptr, out))) {
+            str_error(p, last, "invalid escape sequence in string");
+            str_token_free(buf, str);
+            return NULL;
+        }
+    }
+
+    *out = '\0';
+
+    int result = ecs_meta_set_string(cursor, str);
+    str_token_free(buf, str);
+    if (result) {
+        str_error(p, start, "invalid string value");
+        return NULL;
+    }
+
+    return last + 1;
+}
+
+static
+const char* str_parse_primitive(
+    str_parser_t *p,
+    ecs_type_op_t *op,
+    const char *ptr)
+{
+    ecs_meta_cursor_t *cursor = p->cursor;
+    const char *start = ptr;
+    int result = 0;
+
+    switch(op->is.primitive) {
+    case EcsBool: {
+        const char *end = str_ident_end(p, ptr);
+        if (str_token_eq(ptr, end, "true")) {
+            result = ecs_meta_set_bool(cursor, true);
+        } else if (str_token_eq(ptr, end, "false")) {
+            result = ecs_meta_set_bool(cursor, false);
+        } else {
+            str_error(p, ptr, "expected true or false");
+            return NULL;
+        }
+        ptr = end;
+        break;
+    }
+    case EcsChar: {
+        char ch = '\0';
+        if (*ptr != '\'' || (ptr + 1) >= p->end) {
+            str_error(p, start, "invalid character");
+            return NULL;
+        }
+
+        /* The 0 character is printed as '' */
+        if (ptr[1] != '\'') {
+            if (!(ptr = str_parse_char(p, ptr + 1, &ch)) ||
+                ptr >= p->end || *ptr != '\'')
+            {
+                str_error(p, start, "invalid character");
+                return NULL;
+            }
+        } else {
+            ptr ++;
+        }
+
+        result = ecs_meta_set_char(cursor, ch);
+        ptr ++;
+        break;
+    }
+    case EcsByte:
+    case EcsU8:
+    case EcsU16:
+    case EcsU32:
+    case EcsU64:
+    case EcsUPtr: {
+        uint64_t value;
+        if (!(ptr = str_parse_u64(p, ptr, &value))) {
+            str_error(p, start, "invalid unsigned integer");
+            return NULL;
+        }
+        result = ecs_meta_set_uint(cursor, value);
+        break;
+    }
+    case EcsI8:
+    case EcsI16:
+    case EcsI32:
+    case EcsI64:
+    case EcsIPtr: {
+        int64_t value;
+        if (!(ptr = str_parse_i64(p, ptr, &value))) {
+            str_error(p, start, "invalid integer");
+            return NULL;
+        }
+        result = ecs_meta_set_int(cursor, value);
+        break;
+    }
+    case EcsF32:
+    case EcsF64: {
+        double value;
+        if (!(ptr = str_parse_f64(p, ptr, &value))) {
+            str_error(p, start, "invalid floating point number");
+            return NULL;
+        }
+        result = ecs_meta_set_float(cursor, value);
+        break;
+    }
+    case EcsString:
+        return str_parse_string(p, ptr);
+    case EcsEntity: {
+        ecs_entity_t e;
+        if (isdigit((unsigned char)*ptr)) {
+            uint64_t value;
+            if (!(ptr = str_parse_u64(p, ptr, &value))) {
+                str_error(p, start, "invalid entity id");
+                return NULL;
+            }
+            e = value;
+        } else {
+            char buf[ECS_META_IDENTIFIER_LENGTH];
+            ptr = str_ident_end(p, ptr);
+            char *path = str_token(buf, start, ptr);
+            e = ecs_lookup_fullpath(cursor->world, path);
+            str_token_free(buf, path);
+            if (!e) {
+                str_error(p, start, "unresolved entity '%.*s'",
+                    (int)(ptr - start), start);
+                return NULL;
+            }
+        }
+        result = ecs_meta_set_entity(cursor, e);
+        break;
+    }
+    }
+
+    if (result) {
+        str_error(p, start, "value '%.*s' out of range",
+            (int)(ptr - start), start);
+        return NULL;
+    }
+
+    return ptr;
+}
+
+static
+const char* str_parse_enum(
+    str_parser_t *p,
+    const char *ptr)
+{
+    char buf[ECS_META_IDENTIFIER_LENGTH];
+    const char *end = str_ident_end(p, ptr);
+    char *name = str_token(buf, ptr, end);
+    int result = ecs_meta_set_enum_name(p->cursor, name);
+    str_token_free(buf, name);
+
+    if (result) {
+        str_error(p, ptr, "invalid constant '%.*s'", (int)(end - ptr), ptr);
+        return NULL;
+    }
+
+    return end;
+}
+
+static
+const char* str_parse_bitmask(
+    str_parser_t *p,
+    const char *ptr)
+{
+    /* Constants and the '|' between them are passed as a single expression */
+    const char *end = ptr;
+    while (end < p->end && (str_is_ident(*end) || *end == '|' ||
+        *end == ' ' || *end == '\t'))
+    {
+        end ++;
+    }
+
+    char buf[ECS_META_IDENTIFIER_LENGTH];
+    char *expr = str_token(buf, ptr, end);
+    int result = ecs_meta_set_bitmask_names(p->cursor, expr);
+    str_token_free(buf, expr);
+
+    if (result) {
+        str_error(p, ptr, "invalid bitmask '%.*s'", (int)(end - ptr), ptr);
+        return NULL;
+    }
+
+    return end;
+}
+
+/* Parse "name =" if the input has a member name at ptr. Returns ptr if there
+ * is no member name. */
+static
+const char* str_parse_member_name(
+    str_parser_t *p,
+    const char *ptr)
+{
+    if (!isalpha((unsigned char)*ptr) && *ptr != '_') {
+        return ptr;
+    }
+
+    const char *end = str_ident_end(p, ptr);
+    const char *next = str_skip_ws(p, end);
+    if (next >= p->end || *next != '=') {
+        return ptr;
+    }
+
+    char buf[ECS_META_IDENTIFIER_LENGTH];
+    char *name = str_token(buf, ptr, end);
+    int result = ecs_meta_move_name(p->cursor, name);
+    str_token_free(buf, name);
+
+    if (result) {
+        str_error(p, ptr, "unknown member '%.*s'", (int)(end - ptr), ptr);
+        return NULL;
+    }
+
+    return str_skip_ws(p, next + 1);
+}
+
+/* Parse ',' or closing bracket after a value. Returns NULL on error, and sets
+ * is_close if the scope was closed. */
+static
+const char* str_parse_separator(
+    str_parser_t *p,
+    const char *ptr,
+    char close,
+    bool *is_close)
+{
+    ptr = str_skip_ws(p, ptr);
+    if (ptr >= p->end) {
+        str_error(p, ptr, "missing '%c'", close);
+        return NULL;
+    }
+
+    if (*ptr == close) {
+        *is_close = true;
+        return ptr + 1;
+    }
+
+    if (*ptr != ',') {
+        str_error(p, ptr, "expected ',' or '%c'", close);
+        return NULL;
+    }
+
+    *is_close = false;
+    return str_skip_ws(p, ptr + 1);
+}
+
+static
+const char* str_open_scope(
+    str_parser_t *p,
+    const char *ptr,
+    char open)
+{
+    if (*ptr != open) {
+        str_error(p, ptr, "expected '%c'", open);
+        return NULL;
+    }
+
+    if (ecs_meta_push(p->cursor)) {
+        str_error(p, ptr, "too many nested scopes");
+        return NULL;
+    }
+
+    return str_skip_ws(p, ptr + 1);
+}
+
+static
+const char* str_parse_struct(
+    str_parser_t *p,
+    const char *ptr)
+{
+    ecs_meta_cursor_t *cursor = p->cursor;
+    bool is_close = false;
+
+    if (!(ptr = str_open_scope(p, ptr, '{'))) {
+        return NULL;
+    }
+
+    if (ptr < p->end && *ptr == '}') {
+        ptr ++;
+        is_close = true;
+    }
+
+    while (!is_close) {
+        if (!(ptr = str_parse_member_name(p, ptr))) {
+            return NULL;
+        }
+
+        if (!(ptr = str_parse_value(p, ptr))) {
+            return NULL;
+        }
+
+        if (!(ptr = str_parse_separator(p, ptr, '}', &is_close))) {
+            return NULL;
+        }
+
+        if (!is_close) {
+            ecs_meta_next(cursor);
+        }
+    }
+
+    ecs_meta_pop(cursor);
+
+    return ptr;
+}
+
+static
+const char* str_parse_elements(
+    str_parser_t *p,
+    const char *ptr)
+{
+    ecs_meta_cursor_t *cursor = p->cursor;
+    bool is_close = false;
+
+    if (!(ptr = str_open_scope(p, ptr, '['))) {
+        return NULL;
+    }
+
+    ecs_meta_scope_t *scope = &cursor->scope[cursor->depth];
+
+    if (ptr < p->end && *ptr == ']') {
+        ptr ++;
+        is_close = true;
+    }
+
+    while (!is_close) {
+        if (scope->count && scope->cur_elem >= scope->count) {
+            str_error(p, ptr, "too many elements for array");
+            return NULL;
+        }
+
+        /* Popping a struct moves to the next element */
+        bool is_struct = ecs_meta_get_op(cursor)->kind == EcsOpPush;
+
+        if (!(ptr = str_parse_value(p, ptr))) {
+            return NULL;
+        }
+
+        if (!(ptr = str_parse_separator(p, ptr, ']', &is_close))) {
+            return NULL;
+        }
+
+        if (!is_close && !is_struct && ecs_meta_next(cursor)) {
+            str_error(p, ptr, "too many elements for array");
+            return NULL;
+        }
+    }
+
+    ecs_meta_pop(cursor);
+
+    return ptr;
+}
+
+static
+const char* str_parse_map(
+    str_parser_t *p,
+    const char *ptr)
+{
+    ecs_meta_cursor_t *cursor = p->cursor;
+    bool is_close = false;
+
+    if (!(ptr = str_open_scope(p, ptr, '{'))) {
+        return NULL;
+    }
+
+    if (ptr < p->end && *ptr == '}') {
+        ptr ++;
+        is_close = true;
+    }
+
+    while (!is_close) {
+        if (!(ptr = str_parse_value(p, ptr))) {
+            return NULL;
+        }
+
+        ptr = str_skip_ws(p, ptr);
+        if (ptr >= p->end || *ptr != '=') {
+            str_error(p, ptr, "expected '=' after map key");
+            return NULL;
+        }
+
+        /* Insert element for key */
+        ecs_meta_next(cursor);
+
+        /* Popping a struct moves to the next key */
+        bool is_struct = ecs_meta_get_op(cursor)->kind == EcsOpPush;
+
+        if (!(ptr = str_parse_value(p, ptr + 1))) {
+            return NULL;
+        }
+
+        if (!is_struct) {
+            ecs_meta_next(cursor);
+        }
+
+        if (!(ptr = str_parse_separator(p, ptr, '}', &is_close))) {
+            return NULL;
+        }
+    }
+
+    ecs_meta_pop(cursor);
+
+    return ptr;
+}
+
+static
+const char* str_parse_value(
+    str_parser_t *p,
+    const char *ptr)
+{
+    ptr = str_skip_ws(p, ptr);
+    if (ptr >= p->end) {
+        str_error(p, ptr, "unexpected end of expression");
+        return NULL;
+    }
+
+    ecs_type_op_t *op = ecs_meta_get_op(p->cursor);
+
+    switch(op->kind) {
+    case EcsOpPush:
+        return str_parse_struct(p, ptr);
+    case EcsOpArray:
+        return str_parse_elements(p, ptr);
+    case EcsOpVector:
+    case EcsOpMap:
+        if (*ptr != '[' && *ptr != '{') {
+            const char *end = str_ident_end(p, ptr);
+            if (str_token_eq(ptr, end, "nullptr")) {
+                ecs_meta_set_null(p->cursor);
+                return end;
+            }
+        }
+
+        if (op->kind == EcsOpVector) {
+            return str_parse_elements(p, ptr);
+        } else {
+            return str_parse_map(p, ptr);
+        }
+    case EcsOpEnum:
+        return str_parse_enum(p, ptr);
+    case EcsOpBitmask:
+        return str_parse_bitmask(p, ptr);
+    case EcsOpPrimitive:
+        return str_parse_primitive(p, op, ptr);
+    case EcsOpHeader:
+    case EcsOpPop:
+    case EcsOpBlit:
+        break;
+    }
+
+    str_error(p, ptr, "too many values for type");
+    return NULL;
+}
+
+static
+const char* str_parse(
+    ecs_meta_cursor_t *cursor,
+    const char *name,
+    const char *expr,
+    const char *end,
+    int64_t offset)
+{
+    str_parser_t p = {
+        .cursor = cursor,
+        .name = name,
+        .expr = expr,
+        .end = end,
+        .offset = offset
+    };
+
+    const char *ptr = str_parse_value(&p, expr);
+    if (ptr) {
+        ptr = str_skip_ws(&p, ptr);
+    }
+
+    return ptr;
+}
+
+const char* ecs_meta_cursor_from_str(
+    ecs_meta_cursor_t *cursor,
+    const char *expr)
+{
+    ecs_assert(cursor != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(expr != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const char *name = ecs_get_name(cursor->world, cursor->scope[0].type);
+
+    return str_parse(cursor, name, expr, expr + ecs_os_strlen(expr), -1);
+}
+
+const char* ecs_meta_from_str(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    const char *expr)
+{
+    ecs_meta_cursor_t cursor = ecs_meta_cursor(world, type, ptr);
+    return ecs_meta_cursor_from_str(&cursor, expr);
+}
+
+ecs_meta_reader_t ecs_meta_reader(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    ecs_meta_read_action_t action,
+    void *ctx)
+{
+    ecs_assert(action != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    return (ecs_meta_reader_t) {
+        .ptr = ptr,
+        .action = action,
+        .ctx = ctx,
+        .cursor = ecs_meta_cursor(world, type, ptr)
+    };
+}
+
+static
+void reader_append(
+    ecs_meta_reader_t *reader,
+    const char *str,
+    ecs_size_t len)
+{
+    if ((reader->count + len) > reader->size) {
+        reader->size = ECS_MAX(reader->size * 2, reader->count + len);
+        reader->size = ECS_MAX(reader->size, ECS_META_IDENTIFIER_LENGTH);
+        reader->buf = ecs_os_realloc(reader->buf, reader->size);
+    }
+
+    ecs_os_memcpy(&reader->buf[reader->count], str, len);
+    reader->count += len;
+}
+
+/* Parse value that ends at end. If no part of the value was buffered, it is
+ * parsed directly from the chunk. */
+static
+int reader_value(
+    ecs_meta_reader_t *reader,
+    const char *chunk,
+    const char *start,
+    const char *end)
+{
+    const char *expr = start;
+    int64_t offset = reader->offset + (start - chunk);
+
+    if (reader->count) {
+        reader_append(reader, start, (ecs_size_t)(end - start));
+        expr = reader->buf;
+        end = &reader->buf[reader->count];
+        offset = reader->buf_offset;
+        reader->count = 0;
+    }
+
+    /* Skip empty values, like the newline after a closing bracket */
+    while (expr < end && isspace((unsigned char)*expr)) {
+        expr ++;
+        offset ++;
+    }
+
+    if (expr == end) {
+        return 0;
+    }
+
+    ecs_meta_cursor_t *cursor = &reader->cursor;
+    const char *name = reader->name;
+    if (!name) {
+        name = ecs_get_name(cursor->world, cursor->scope[0].type);
+    }
+
+    ecs_meta_cursor_reset(cursor, reader->ptr);
+
+    const char *ptr = str_parse(cursor, name, expr, end, offset);
+    if (!ptr) {
+        goto error;
+    }
+
+    if (ptr != end) {
+        str_parser_t p = { .name = name, .expr = expr, .offset = offset };
+        str_error(&p, ptr, "unexpected '%c' after value", *ptr);
+        goto error;
+    }
+
+    if (reader->action(cursor->world, cursor->scope[0].type, reader->ptr,
+        reader->ctx))
+    {
+        goto error;
+    }
+
+    return 0;
+error:
+    reader->failed = true;
+    return -1;
+}
+
+int ecs_meta_reader_feed(
+    ecs_meta_reader_t *reader,
+    const char *chunk,
+    ecs_size_t len)
+{
+    ecs_assert(reader != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(chunk != NULL || !len, ECS_INVALID_PARAMETER, NULL);
+
+    if (reader->failed) {
+        return -1;
+    }
+
+    const char *ptr, *start = chunk, *end = &chunk[len];
+
+    /* Find where values end, without parsing them */
+    for (ptr = chunk; ptr < end; ptr ++) {
+        char ch = *ptr;
+
+        if (reader->quote) {
+            if (reader->escape) {
+                reader->escape = false;
+            } else if (ch == '\\') {
+                reader->escape = true;
+            } else if (ch == reader->quote) {
+                reader->quote = 0;
+            }
+            continue;
+        }
+
+        switch(ch) {
+        case '"':
+        case '\'':
+            reader->quote = ch;
+            break;
+        case '{':
+        case '[':
+            reader->depth ++;
+            break;
+        case '}':
+        case ']':
+            /* Unbalanced brackets are reported by the parser */
+            if (reader->depth) {
+                reader->depth --;
+            }
+            if (!reader->depth) {
+                if (reader_value(reader, chunk, start, ptr + 1)) {
+                    return -1;
+                }
+                start = ptr + 1;
+            }
+            break;
+        case ',':
+        case '\n':
+            if (!reader->depth) {
+                if (reader_value(reader, chunk, start, ptr)) {
+                    return -1;
+                }
+                start = ptr + 1;
+            }
+            break;
+        }
+    }
+
+    if (start < end) {
+        if (!reader->count) {
+            reader->buf_offset = reader->offset + (start - chunk);
+        }
+        reader_append(reader, start, (ecs_size_t)(end - start));
+    }
+
+    reader->offset += len;
+
+    return 0;
+}
+
+int ecs_meta_reader_fini(
+    ecs_meta_reader_t *reader)
+{
+    ecs_assert(reader != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    int result = reader->failed ? -1 : 0;
+
+    if (!result && reader->count) {
+        result = reader_value(reader, reader->buf, reader->buf, reader->buf);
+    }
+
+    ecs_os_free(reader->buf);
+    reader->buf = NULL;
+    reader->size = 0;
+    reader->count = 0;
+
+    return result;
+}
@@ -0,0 +1,414 @@
+#include <flecs_meta.h>
+#include "serializer.h"
+#include "lifecycle.h"
+#include "world.h"
+
+/* Serializers are cached in a table indexed by component id. The table is
+ * split up in pages, so that pointers to entries stay valid when it grows.
+ * Entries are copies of the serializer component. They are written when a
+ * serializer is built, updated or deleted, so that lookups never write. */
+#define SERIALIZER_PAGE_BITS (8)
+#define SERIALIZER_PAGE_SIZE (1 << SERIALIZER_PAGE_BITS)
+#define SERIALIZER_PAGE_MASK (SERIALIZER_PAGE_SIZE - 1)
+#define SERIALIZER_MAX_ID (1 << 20)
+
+/* Anonymous collection types are interned by their definition. The map stores
+ * the index of the first entry for a hash, entries with the same hash are
+ * chained through their next index. */
+typedef struct intern_entry_t {
+    ecs_type_kind_t kind;
+    int32_t count;
+    ecs_entity_t key_type;
+    ecs_entity_t element_type;
+    ecs_entity_t type;
+    int32_t next;
+} intern_entry_t;
+
+typedef struct serializer_entry_t {
+    ecs_entity_t type;
+    EcsMetaTypeSerializer ser;
+} serializer_entry_t;
+
+typedef struct meta_world_t {
+    ecs_world_t *world;
+    struct meta_world_t *next;
+    FlecsMeta module;
+    serializer_entry_t **pages;
+    int32_t page_count;
+    ecs_vector_t *interned;
+    ecs_map_t *intern_index;
+    ecs_map_t *dependents; /* Vector of ecs_meta_dependent_t per type */
+    ecs_map_t *components; /* Components with generated lifecycle actions */
+} meta_world_t;
+
+/* Meta worlds are kept in a list that is separate from the worlds, so that
+ * the world context remains available to the application. Worlds are added
+ * when the module is imported and removed by ecs_fini. An application rarely
+ * has more than a few worlds, so the list is searched linearly. Worlds that
+ * import the module must not be created or deleted while another thread uses
+ * the module. */
+static meta_world_t *meta_worlds;
+
+/* Returns NULL if the module is not imported, or after the meta world is
+ * freed by ecs_fini. */
+static
+meta_world_t* get_world(
+    ecs_world_t *world)
+{
+    meta_world_t *w = meta_worlds;
+    while (w && w->world != world) {
+        w = w->next;
+    }
+
+    return w;
+}
+
+static
+void remove_world(
+    meta_world_t *w)
+{
+    meta_world_t **ptr = &meta_worlds;
+    while (*ptr != w) {
+        ptr = &(*ptr)->next;
+    }
+
+    *ptr = w->next;
+}
+
+static
+void fini_world(
+    ecs_world_t *world,
+    void *ctx)
+{
+    meta_world_t *w = ctx;
+
+    /* Components are deleted after fini actions, at which point serializers
+     * may already be deleted. Release resources while the store is intact. */
+    ecs_vector_t *components = NULL;
+    ecs_map_each(w->components, bool, key, value, {
+        ecs_entity_t *e = ecs_vector_add(&components, ecs_entity_t);
+        *e = (ecs_entity_t)key;
+    });
+
+    ecs_meta_fini_components(world, components);
+    ecs_vector_free(components);
+    ecs_map_free(w->components);
+
+    int32_t i;
+    for (i = 0; i < w->page_count; i ++) {
+        ecs_os_free(w->pages[i]);
+    }
+
+    remove_world(w);
+
+    ecs_map_each(w->dependents, ecs_vector_t*, key, deps, {
+        ecs_vector_free(*deps);
+    });
+
+    ecs_map_free(w->dependents);
+    ecs_vector_free(w->interned);
+    ecs_map_free(w->intern_index);
+    ecs_os_free(w->pages);
+    ecs_os_free(w);
+}
+
+#define LOOKUP_HANDLE(module, T, path)\
+    (module)->ecs_entity(T) = ecs_lookup_fullpath(world, path);\
+    (module)->ecs_type(T) = ecs_type_from_entity(world, (module)->ecs_entity(T))
+
+static
+void lookup_module(
+    ecs_world_t *world,
+    FlecsMeta *module)
+{
+    ecs_assert(ecs_lookup_fullpath(world, "flecs.meta.MetaType") != 0, 
+        ECS_MODULE_UNDEFINED, "flecs.meta");
+
+    LOOKUP_HANDLE(module, EcsPrimitive, "flecs.meta.Primitive");
+    LOOKUP_HANDLE(module, EcsEnum, "flecs.meta.Enum");
+    LOOKUP_HANDLE(module, EcsBitmask, "flecs.meta.Bitmask");
+    LOOKUP_HANDLE(module, EcsStruct, "flecs.meta.Struct");
+    LOOKUP_HANDLE(module, EcsArray, "flecs.meta.Array");
+    LOOKUP_HANDLE(module, EcsVector, "flecs.meta.Vector");
+    LOOKUP_HANDLE(module, EcsMap, "flecs.meta.Map");
+    LOOKUP_HANDLE(module, EcsMetaType, "flecs.meta.MetaType");
+    LOOKUP_HANDLE(module, EcsMetaTypeSerializer, 
+        "flecs.meta.MetaTypeSerializer");
+}
+
+void ecs_meta_world_init(
+    ecs_world_t *world,
+    const FlecsMeta *module)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        w = ecs_os_calloc(ECS_SIZEOF(meta_world_t));
+        w->world = world;
+        w->next = meta_worlds;
+        meta_worlds = w;
+        ecs_atfini(world, fini_world, w);
+    }
+
+    w->module = *module;
+}
+
+bool ecs_meta_world_is_fini(
+    ecs_world_t *world)
+{
+    return get_world(world) == NULL;
+}
+
+const FlecsMeta* ecs_meta_get_module(
+    ecs_world_t *world,
+    FlecsMeta *storage)
+{
+    meta_world_t *w = get_world(world);
+    if (w) {
+        return &w->module;
+    }
+
+    lookup_module(world, storage);
+    return storage;
+}
+
+static
+serializer_entry_t* find_entry(
+    meta_world_t *w,
+    ecs_entity_t type)
+{
+    uint32_t id = (uint32_t)type;
+    int32_t page = (int32_t)(id >> SERIALIZER_PAGE_BITS);
+    if (id >= SERIALIZER_MAX_ID || page >= w->page_count || !w->pages[page]) {
+        return NULL;
+    }
+
+    return &w->pages[page][id & SERIALIZER_PAGE_MASK];
+}
+
+static
+serializer_entry_t* ensure_entry(
+    meta_world_t *w,
+    ecs_entity_t type)
+{
+    uint32_t id = (uint32_t)type;
+    if (id >= SERIALIZER_MAX_ID) {
+        return NULL;
+    }
+
+    int32_t page = (int32_t)(id >> SERIALIZER_PAGE_BITS);
+    if (page >= w->page_count) {
+        int32_t count = page + 1;
+        w->pages = ecs_os_realloc(w->pages, 
+            ECS_SIZEOF(serializer_entry_t*) * count);
+        memset(&w->pages[w->page_count], 0, 
+            sizeof(serializer_entry_t*) * (size_t)(count - w->page_count));
+        w->page_count = count;
+    }
+
+    if (!w->pages[page]) {
+        w->pages[page] = ecs_os_calloc(
+            ECS_SIZEOF(serializer_entry_t) * SERIALIZER_PAGE_SIZE);
+    }
+
+    return &w->pages[page][id & SERIALIZER_PAGE_MASK];
+}
+
+void ecs_meta_cache_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const EcsMetaTypeSerializer *ser)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        return;
+    }
+
+    serializer_entry_t *entry;
+    if (ser) {
+        entry = ensure_entry(w, type);
+    } else {
+        entry = find_entry(w, type);
+    }
+
+    if (!entry) {
+        return;
+    }
+
+    if (ser) {
+        entry->type = type;
+        entry->ser = *ser;
+    } else if (entry->type == type) {
+        entry->type = 0;
+    }
+}
+
+const EcsMetaTypeSerializer* ecs_meta_get_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        FlecsMeta module;
+        lookup_module(world, &module);
+        return ecs_get_w_entity(world, type, 
+            module.ecs_entity(EcsMetaTypeSerializer));
+    }
+
+    serializer_entry_t *entry = find_entry(w, type);
+    if (entry && entry->type == type) {
+        return &entry->ser;
+    }
+
+    return ecs_get_w_entity(world, type, 
+        w->module.ecs_entity(EcsMetaTypeSerializer));
+}
+
+static
+uint64_t intern_hash(
+    ecs_type_kind_t kind,
+    ecs_entity_t key_type,
+    ecs_entity_t element_type,
+    int32_t count)
+{
+    uint64_t hash = (uint64_t)kind;
+    hash = hash * 31 + key_type;
+    hash = hash * 31 + element_type;
+    hash = hash * 31 + (uint64_t)count;
+    return hash;
+}
+
+ecs_entity_t ecs_meta_find_interned(
+    ecs_world_t *world,
+    ecs_type_kind_t kind,
+    ecs_entity_t key_type,
+    ecs_entity_t element_type,
+    int32_t count)
+{
+    meta_world_t *w = get_world(world);
+    if (!w || !w->intern_index) {
+        return 0;
+    }
+
+    int32_t *head = ecs_map_get(w->intern_index, int32_t, 
+        intern_hash(kind, key_type, element_type, count));
+    if (!head) {
+        return 0;
+    }
+
+    intern_entry_t *entries = ecs_vector_first(w->interned, intern_entry_t);
+    int32_t i;
+    for (i = *head; i != -1; i = entries[i].next) {
+        intern_entry_t *entry = &entries[i];
+        if (entry->kind == kind && entry->key_type == key_type &&
+            entry->element_type == element_type && entry->count == count)
+        {
+            /* Type may have been deleted by the application */
+            if (ecs_is_alive(world, entry->type)) {
+                return entry->type;
+            }
+        }
+    }
+
+    return 0;
+}
+
+void ecs_meta_intern(
+    ecs_world_t *world,
+    ecs_type_kind_t kind,
+    ecs_entity_t key_type,
+    ecs_entity_t element_type,
+    int32_t count,
+    ecs_entity_t type)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        return;
+    }
+
+    if (!w->intern_index) {
+        w->intern_index = ecs_map_new(int32_t, 0);
+    }
+
+    uint64_t hash = intern_hash(kind, key_type, element_type, count);
+    int32_t *head = ecs_map_get(w->intern_index, int32_t, hash);
+    int32_t index = ecs_vector_count(w->interned);
+
+    intern_entry_t *entry = ecs_vector_add(&w->interned, intern_entry_t);
+    *entry = (intern_entry_t){
+        .kind = kind,
+        .count = count,
+        .key_type = key_type,
+        .element_type = element_type,
+        .type = type,
+        .next = head ? *head : -1
+    };
+
+    ecs_map_set(w->intern_index, hash, &index);
+}
+
+void ecs_meta_add_dependent(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    ecs_entity_t dependent,
+    bool is_inline)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        return;
+    }
+
+    if (!w->dependents) {
+        w->dependents = ecs_map_new(ecs_vector_t*, 0);
+    }
+
+    ecs_vector_t **deps = ecs_map_get(w->dependents, ecs_vector_t*, type);
+    ecs_vector_t *vec = deps ? *deps : NULL;
+
+    ecs_vector_each(vec, ecs_meta_dependent_t, dep, {
+        if (dep->type == dependent) {
+            dep->is_inline |= is_inline;
+            return;
+        }
+    });
+
+    ecs_meta_dependent_t *dep = ecs_vector_add(&vec, ecs_meta_dependent_t);
+    dep->type = dependent;
+    dep->is_inline = is_inline;
+
+    ecs_map_set(w->dependents, type, &vec);
+}
+
+ecs_vector_t* ecs_meta_get_dependents(
+    ecs_world_t *world,
+    ecs_entity_t type)
+{
+    meta_world_t *w = get_world(world);
+    if (!w || !w->dependents) {
+        return NULL;
+    }
+
+    ecs_vector_t **deps = ecs_map_get(w->dependents, ecs_vector_t*, type);
+    return deps ? *deps : NULL;
+}
+
+bool ecs_meta_add_component(
+    ecs_world_t *world,
+    ecs_entity_t component)
+{
+    meta_world_t *w = get_world(world);
+    if (!w) {
+        return false;
+    }
+
+    if (!w->components) {
+        w->components = ecs_map_new(bool, 0);
+    }
+
+    if (ecs_map_get(w->components, bool, component)) {
+        return false;
+    }
+
+    bool value = true;
+    ecs_map_set(w->components, component, &value);
+    return true;
+}
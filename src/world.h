@@ -0,0 +1,82 @@
+#ifndef FLECS_META_WORLD_H
+#define FLECS_META_WORLD_H
+
+#include "flecs_meta.h"
+
+/* Create per-world data of the module, and store the handles of the meta
+ * components. Called when the module is imported. The data is freed by
+ * ecs_fini. */
+void ecs_meta_world_init(
+    ecs_world_t *world,
+    const FlecsMeta *module);
+
+/* Returns true if the world has no meta data, either because the module is
+ * not imported or because the world is being deleted */
+bool ecs_meta_world_is_fini(
+    ecs_world_t *world);
+
+/* Get handles of the meta components. When the world has no meta data, which
+ * is the case while ecs_fini deletes components, the handles are resolved
+ * into the provided storage. */
+const FlecsMeta* ecs_meta_get_module(
+    ecs_world_t *world,
+    FlecsMeta *storage);
+
+/* Update cached copy of the serializer of a type. Must be called each time a
+ * serializer is built or modified, and with NULL when it is deleted. */
+void ecs_meta_cache_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    const EcsMetaTypeSerializer *ser);
+
+/* Type that depends on the definition of another type */
+typedef struct ecs_meta_dependent_t {
+    ecs_entity_t type;
+    bool is_inline;     /* Ops of the type are inlined, not only referenced */
+} ecs_meta_dependent_t;
+
+/* Register that the serializer of dependent uses the serializer of type */
+void ecs_meta_add_dependent(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    ecs_entity_t dependent,
+    bool is_inline);
+
+/* Get vector of ecs_meta_dependent_t with the types that depend on type. The
+ * vector may be reallocated when dependents are added. */
+ecs_vector_t* ecs_meta_get_dependents(
+    ecs_world_t *world,
+    ecs_entity_t type);
+
+/* Get serializer of a type, or NULL if the type has no serializer */
+const EcsMetaTypeSerializer* ecs_meta_get_serializer(
+    ecs_world_t *world,
+    ecs_entity_t type);
+
+/* Find anonymous array, vector or map type with the same definition. Unused
+ * parameters (the key type for arrays and vectors, and the count for vectors
+ * and maps) must be 0. Returns 0 if no such type was registered. */
+ecs_entity_t ecs_meta_find_interned(
+    ecs_world_t *world,
+    ecs_type_kind_t kind,
+    ecs_entity_t key_type,
+    ecs_entity_t element_type,
+    int32_t count);
+
+/* Register anonymous type so it is returned by ecs_meta_find_interned */
+void ecs_meta_intern(
+    ecs_world_t *world,
+    ecs_type_kind_t kind,
+    ecs_entity_t key_type,
+    ecs_entity_t element_type,
+    int32_t count,
+    ecs_entity_t type);
+
+/* Register component with generated lifecycle actions. Values of registered
+ * components are released when the world is deleted. Returns false if the
+ * component was already registered. */
+bool ecs_meta_add_component(
+    ecs_world_t *world,
+    ecs_entity_t component);
+
+#endif
@@ -0,0 +1,441 @@
+#include <test.h>
+#include <locale.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Line, {
+    Point start;
+    Point stop;
+});
+
+ECS_STRUCT(Primitives, {
+    bool b;
+    char ch;
+    ecs_byte_t byte;
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+    int64_t i64;
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+    float f32;
+    double f64;
+    char *str;
+    ecs_entity_t e;
+});
+
+ECS_ENUM(Color, {
+    Red,
+    Green,
+    Blue
+});
+
+ECS_BITMASK(Toppings, {
+    Bacon = 1,
+    Lettuce = 2,
+    Tomato = 4
+});
+
+ECS_STRUCT(Sandwich, {
+    Color color;
+    Toppings toppings;
+});
+
+ECS_STRUCT(Collections, {
+    int32_t arr[3];
+    ecs_vector(int32_t) vec;
+    ecs_vector(Point) points;
+    ecs_map(int32_t, Point) map;
+});
+
+void FromStr_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    Point value = { 0 };
+    const char *ptr = ecs_meta_from_str(
+        world, ecs_entity(Point), &value, "{x = 10, y = 20}");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+    test_int(value.x, 10);
+    test_int(value.y, 20);
+
+    ptr = ecs_meta_from_str(
+        world, ecs_entity(Point), &value, " { y = -1 ,x = -2 } ");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+    test_int(value.x, -2);
+    test_int(value.y, -1);
+
+    ptr = ecs_meta_from_str(world, ecs_entity(Point), &value, "{30, 40}");
+    test_assert(ptr != NULL);
+    test_int(value.x, 30);
+    test_int(value.y, 40);
+
+    ecs_fini(world);
+}
+
+void FromStr_nested_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    Line value = {{ 0 }};
+    const char *ptr = ecs_meta_from_str(world, ecs_entity(Line), &value,
+        "{start = {x = 10, y = 20}, stop = {30, 40}}");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+    test_int(value.start.x, 10);
+    test_int(value.start.y, 20);
+    test_int(value.stop.x, 30);
+    test_int(value.stop.y, 40);
+
+    ecs_fini(world);
+}
+
+void FromStr_primitives() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Primitives);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo"});
+
+    Primitives value = { 0 };
+    const char *ptr = ecs_meta_from_str(world, ecs_entity(Primitives), &value,
+        "{b = true, ch = 'a', byte = 0xff, i8 = -128, i16 = -32768, "
+        "i32 = -2147483648, i64 = -9223372036854775808, u8 = 255, "
+        "u16 = 65535, u32 = 4294967295, u64 = 18446744073709551615, "
+        "f32 = 0.5, f64 = 1e-7, str = \"Hello\", e = Foo}");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+
+    test_bool(value.b, true);
+    test_int(value.ch, 'a');
+    test_int(value.byte, 0xff);
+    test_int(value.i8, INT8_MIN);
+    test_int(value.i16, INT16_MIN);
+    test_int(value.i32, INT32_MIN);
+    test_assert(value.i64 == INT64_MIN);
+    test_int(value.u8, UINT8_MAX);
+    test_int(value.u16, UINT16_MAX);
+    test_assert(value.u32 == UINT32_MAX);
+    test_assert(value.u64 == UINT64_MAX);
+    test_flt(value.f32, 0.5);
+    test_assert(value.f64 == 1e-7);
+    test_str(value.str, "Hello");
+    test_assert(value.e == e);
+
+    ecs_os_free(value.str);
+
+    ecs_fini(world);
+}
+
+void FromStr_string_escape() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Primitives);
+
+    Primitives value = { 0 };
+    const char *ptr = ecs_meta_from_str(world, ecs_entity(Primitives), &value,
+        "{ch = '\\'', str = \"say \\\"hi\\\"\\n\"}");
+    test_assert(ptr != NULL);
+    test_int(value.ch, '\'');
+    test_str(value.str, "say \"hi\"\n");
+
+    ptr = ecs_meta_from_str(
+        world, ecs_entity(Primitives), &value, "{ch = '', str = nullptr}");
+    test_assert(ptr != NULL);
+    test_int(value.ch, 0);
+    test_assert(value.str == NULL);
+
+    ecs_fini(world);
+}
+
+void FromStr_enum_bitmask() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Color);
+    ECS_META(world, Toppings);
+    ECS_META(world, Sandwich);
+
+    Sandwich value = { 0 };
+    const char *ptr = ecs_meta_from_str(world, ecs_entity(Sandwich), &value,
+        "{color = Blue, toppings = Bacon | Tomato}");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+    test_int(value.color, Blue);
+    test_int(value.toppings, Bacon | Tomato);
+
+    test_assert(ecs_meta_from_str(world, ecs_entity(Sandwich), &value,
+        "{color = Purple}") == NULL);
+
+    ecs_fini(world);
+}
+
+void FromStr_collections() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Collections);
+
+    Collections value = {{ 0 }};
+    const char *ptr = ecs_meta_from_str(
+        world, ecs_entity(Collections), &value,
+        "{arr = [1, 2, 3], vec = [4, 5, 6, 7], "
+        "points = [{x = 1, y = 2}, {3, 4}], "
+        "map = {1 = {x = 10, y = 20}, 2 = {30, 40}}}");
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+
+    test_int(value.arr[0], 1);
+    test_int(value.arr[1], 2);
+    test_int(value.arr[2], 3);
+
+    test_int(ecs_vector_count(value.vec), 4);
+    int32_t *ints = ecs_vector_first(value.vec, int32_t);
+    test_int(ints[0], 4);
+    test_int(ints[3], 7);
+
+    test_int(ecs_vector_count(value.points), 2);
+    Point *points = ecs_vector_first(value.points, Point);
+    test_int(points[0].x, 1);
+    test_int(points[1].y, 4);
+
+    test_int(ecs_map_count(value.map), 2);
+    Point *p = ecs_map_get(value.map, Point, 2);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ptr = ecs_meta_from_str(world, ecs_entity(Collections), &value,
+        "{vec = [], points = nullptr, map = {}}");
+    test_assert(ptr != NULL);
+    test_int(ecs_vector_count(value.vec), 0);
+    test_assert(value.points == NULL);
+    test_int(ecs_map_count(value.map), 0);
+
+    test_assert(ecs_meta_from_str(world, ecs_entity(Collections), &value,
+        "{arr = [1, 2, 3, 4]}") == NULL);
+
+    ecs_vector_free(value.vec);
+    ecs_map_free(value.map);
+
+    ecs_fini(world);
+}
+
+void FromStr_round_trip() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Primitives);
+
+    Primitives value = {
+        .b = true, .ch = '\n', .byte = 10, .i8 = -8, .i16 = -16, .i32 = -32,
+        .i64 = -64, .u8 = 8, .u16 = 16, .u32 = 32, .u64 = 64, .f32 = 0.1f,
+        .f64 = 1.0 / 3.0, .str = "a \"quoted\" string"
+    };
+
+    char *str = ecs_ptr_to_str(world, ecs_entity(Primitives), &value);
+    test_assert(str != NULL);
+
+    Primitives result = { 0 };
+    const char *ptr = ecs_meta_from_str(
+        world, ecs_entity(Primitives), &result, str);
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+    test_assert(ecs_meta_equals(
+        world, ecs_entity(Primitives), &value, &result));
+
+    ecs_os_free(result.str);
+    ecs_os_free(str);
+
+    ecs_fini(world);
+}
+
+void FromStr_invalid() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    Point value = { 0 };
+    ecs_entity_t t = ecs_entity(Point);
+
+    test_assert(ecs_meta_from_str(world, t, &value, "{x = 10") == NULL);
+    test_assert(ecs_meta_from_str(world, t, &value, "{z = 10}") == NULL);
+    test_assert(ecs_meta_from_str(world, t, &value, "{1, 2, 3}") == NULL);
+    test_assert(ecs_meta_from_str(world, t, &value, "{x = 1 y = 2}") == NULL);
+    test_assert(ecs_meta_from_str(world, t, &value, "{x = 1.5}") == NULL);
+    test_assert(ecs_meta_from_str(world, t, &value, "[1, 2]") == NULL);
+
+    ecs_fini(world);
+}
+
+static
+int add_point(
+    ecs_world_t *world,
+    ecs_entity_t type,
+    void *ptr,
+    void *ctx)
+{
+    ecs_vector_t **points = ctx;
+    Point *p = ecs_vector_add(points, Point);
+    *p = *(Point*)ptr;
+    return 0;
+}
+
+void FromStr_reader_chunks() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    const char *stream = "{x = 1, y = 2}\n{x = 3, y = 4}, {5, 6}\n{x = 7,\ny = 8}";
+    ecs_size_t len = ecs_os_strlen(stream);
+
+    /* Values must be the same for every way the stream is split in chunks */
+    ecs_size_t chunk;
+    for (chunk = 1; chunk <= len; chunk ++) {
+        ecs_vector_t *points = NULL;
+        Point value;
+        ecs_meta_reader_t reader = ecs_meta_reader(
+            world, ecs_entity(Point), &value, add_point, &points);
+
+        ecs_size_t i;
+        for (i = 0; i < len; i += chunk) {
+            ecs_size_t count = len - i < chunk ? len - i : chunk;
+            test_int(ecs_meta_reader_feed(&reader, &stream[i], count), 0);
+        }
+
+        test_int(ecs_meta_reader_fini(&reader), 0);
+
+        test_int(ecs_vector_count(points), 4);
+        Point *p = ecs_vector_first(points, Point);
+        test_int(p[0].x, 1);
+        test_int(p[0].y, 2);
+        test_int(p[1].x, 3);
+        test_int(p[1].y, 4);
+        test_int(p[2].x, 5);
+        test_int(p[2].y, 6);
+        test_int(p[3].x, 7);
+        test_int(p[3].y, 8);
+
+        ecs_vector_free(points);
+    }
+
+    ecs_fini(world);
+}
+
+void FromStr_reader_invalid() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    ecs_vector_t *points = NULL;
+    Point value;
+    ecs_meta_reader_t reader = ecs_meta_reader(
+        world, ecs_entity(Point), &value, add_point, &points);
+
+    test_int(ecs_meta_reader_feed(&reader, "{1, 2}\n{3, ", 11), 0);
+    test_int(ecs_meta_reader_feed(&reader, "foo}\n{5, 6}", 11), -1);
+
+    /* Reader does not continue after an error */
+    test_int(ecs_meta_reader_feed(&reader, "\n{7, 8}", 7), -1);
+    test_int(ecs_meta_reader_fini(&reader), -1);
+
+    test_int(ecs_vector_count(points), 1);
+
+    ecs_vector_free(points);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Doubles, {
+    double values[8];
+});
+
+static
+void test_double_round_trip(
+    ecs_world_t *world,
+    ecs_entity_t type)
+{
+    Doubles value = {{
+        0.1 + 0.2, 1.0 / 3.0, 2.0 / 3.0, 1.7976931348623157e308,
+        2.2250738585072014e-308, 4.9406564584124654e-324,
+        123456789.12345678, -9007199254740993.0
+    }};
+
+    char *str = ecs_ptr_to_str(world, type, &value);
+    test_assert(str != NULL);
+
+    Doubles result = {{ 0 }};
+    const char *ptr = ecs_meta_from_str(world, type, &result, str);
+    test_assert(ptr != NULL);
+    test_str(ptr, "");
+
+    int i;
+    for (i = 0; i < 8; i ++) {
+        test_assert(result.values[i] == value.values[i]);
+    }
+
+    /* Numbers with 17 significant digits */
+    ptr = ecs_meta_from_str(world, type, &result,
+        "{values = [0.30000000000000004, 0.33333333333333331, "
+        "1.7976931348623157e308, 12345678901234567, 0, 0, 0, 0]}");
+    test_assert(ptr != NULL);
+    test_assert(result.values[0] == 0.1 + 0.2);
+    test_assert(result.values[1] == 1.0 / 3.0);
+    test_assert(result.values[2] == 1.7976931348623157e308);
+    test_assert(result.values[3] == 12345678901234567.0);
+
+    ecs_os_free(str);
+}
+
+void FromStr_double_round_trip() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Doubles);
+
+    test_double_round_trip(world, ecs_entity(Doubles));
+
+    /* Parsing does not depend on the decimal point of the locale */
+    const char *locales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR"};
+    char *prev = ecs_os_strdup(setlocale(LC_NUMERIC, NULL));
+    int i;
+    for (i = 0; i < 4; i ++) {
+        if (setlocale(LC_NUMERIC, locales[i])) {
+            test_double_round_trip(world, ecs_entity(Doubles));
+            break;
+        }
+    }
+    setlocale(LC_NUMERIC, prev);
+    ecs_os_free(prev);
+
+    ecs_fini(world);
+}
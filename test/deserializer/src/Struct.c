@@ -26,6 +26,25 @@ ECS_STRUCT(Primitives, {
     ecs_entity_t e;
 });
 
+ECS_ENUM(Color, {
+    Red,
+    Green,
+    Blue
+});
+
+ECS_BITMASK(Toppings, {
+    Bacon = 1,
+    Lettuce = 2,
+    Tomato = 4,
+    BLT = 7
+});
+
+ECS_STRUCT(Struct_w_enum, {
+    int32_t before;
+    Color color;
+    int32_t after;
+});
+
 ECS_STRUCT(Struct_w_array, {
     bool before_arr_1;
     int32_t arr_1[2];
@@ -50,6 +69,13 @@ ECS_STRUCT(Struct_w_vector, {
     bool after_vec_2;
 });
 
+ECS_STRUCT(Struct_w_map, {
+    bool before_map;
+    ecs_map(int32_t, int32_t) ints;
+    ecs_map(int32_t, Point) points;
+    bool after_map;
+});
+
 ECS_STRUCT(Struct_w_vector_nested_struct, {
     bool before_vec_1;
     ecs_vector(Point) vec_1;
@@ -991,3 +1017,616 @@ void Struct_struct_reassign_vector_null() {
 
     ecs_fini(world);
 }
+
+void Struct_struct_w_enum_by_name() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Color);
+    ECS_META(world, Struct_w_enum);
+
+    Struct_w_enum value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_enum), &value);
+    
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, 10), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_enum_name(&it, "Blue"), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 20), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    
+    test_int(value.before, 10);
+    test_int(value.color, Blue);
+    test_int(value.after, 20);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_enum_invalid_name() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Color);
+    ECS_META(world, Struct_w_enum);
+
+    Struct_w_enum value = { 0, Green, 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_enum), &value);
+    
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_enum_name(&it, "Blue"), -1);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_enum_name(&it, "Purple"), -1);
+    test_int(ecs_meta_set_int(&it, 1), -1);
+    test_int(ecs_meta_pop(&it), 0);
+    
+    test_int(value.color, Green);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_bitmask_by_name() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Toppings);
+
+    Toppings value = 0;
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Toppings), &value);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "Bacon | Lettuce"), 0);
+    test_int(value, Bacon | Lettuce);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "Tomato"), 0);
+    test_int(value, Tomato);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "BLT"), 0);
+    test_int(value, Bacon | Lettuce | Tomato);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "0"), 0);
+    test_int(value, 0);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "Bacon | Cheese"), -1);
+    test_int(ecs_meta_set_bitmask_names(&it, "Bacon |"), -1);
+    test_int(value, 0);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_move_name_invalid() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    Line value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(world, ecs_entity(Line), &value);
+    
+    test_int(ecs_meta_push(&it), 0);
+
+    /* Members of nested struct are not in the scope of the parent */
+    test_int(ecs_meta_move_name(&it, "x"), -1);
+    test_int(ecs_meta_move_name(&it, "z"), -1);
+
+    test_int(ecs_meta_move_name(&it, "stop"), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "start"), -1);
+    test_int(ecs_meta_move_name(&it, "y"), 0);
+    test_int(ecs_meta_set_int(&it, 44), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_meta_pop(&it), 0);
+    
+    test_int(value.start.x, 0);
+    test_int(value.start.y, 0);
+    test_int(value.stop.x, 0);
+    test_int(value.stop.y, 44);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_vector_set_int_array() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Struct_w_vector);
+
+    Struct_w_vector value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_vector), &value);
+
+    int64_t values[] = {10, 20, 30, 40, 50};
+    
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "vec_1"), 0);
+    test_int(ecs_meta_push_n(&it, 5), 0);
+    test_int(ecs_meta_set_int_array(&it, values, 3), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int_array(&it, &values[3], 2), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_meta_move_name(&it, "vec_2"), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, 60), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int_array(&it, values, 2), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_vector_count(value.vec_1), 5);
+    test_assert(ecs_vector_size(value.vec_1) >= 5);
+    test_int(ecs_vector_count(value.vec_2), 3);
+
+    int32_t *arr_1 = ecs_vector_first(value.vec_1, int32_t);
+    test_int(arr_1[0], 10);
+    test_int(arr_1[1], 20);
+    test_int(arr_1[2], 30);
+    test_int(arr_1[3], 40);
+    test_int(arr_1[4], 50);
+
+    int32_t *arr_2 = ecs_vector_first(value.vec_2, int32_t);
+    test_int(arr_2[0], 60);
+    test_int(arr_2[1], 10);
+    test_int(arr_2[2], 20);
+
+    ecs_vector_free(value.vec_1);
+    ecs_vector_free(value.vec_2);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_array_set_int_array_invalid() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Struct_w_array);
+
+    Struct_w_array value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_array), &value);
+
+    int64_t values[] = {10, 20, 30};
+    int64_t out_of_range[] = {10, (int64_t)INT32_MAX + 1};
+    double floats[] = {1.0, 2.0};
+    
+    test_int(ecs_meta_push(&it), 0);
+
+    /* Not a collection */
+    test_int(ecs_meta_set_int_array(&it, values, 1), -1);
+
+    test_int(ecs_meta_move_name(&it, "arr_1"), 0);
+    test_int(ecs_meta_push_n(&it, 3), -1);
+    test_int(ecs_meta_push_n(&it, 2), 0);
+    test_int(ecs_meta_set_int_array(&it, values, 3), -1);
+    test_int(ecs_meta_set_int_array(&it, out_of_range, 2), -1);
+    test_int(ecs_meta_set_float_array(&it, floats, 2), -1);
+    test_int(ecs_meta_set_int_array(&it, values, 2), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(value.arr_1[0], 10);
+    test_int(value.arr_1[1], 20);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_map() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Struct_w_map);
+
+    Struct_w_map value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_map), &value);
+    
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_bool(&it, true), 0); // before_map
+    test_int(ecs_meta_next(&it), 0);
+
+    test_int(ecs_meta_push_n(&it, 2), 0); // ints
+    test_int(ecs_meta_set_int(&it, 1), 0); // key
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 10), 0); // value
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 2), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 20), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_meta_push(&it), 0); // points
+    test_int(ecs_meta_set_int(&it, 3), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "y"), 0);
+    test_int(ecs_meta_set_int(&it, 40), 0);
+    test_int(ecs_meta_move_name(&it, "x"), 0);
+    test_int(ecs_meta_set_int(&it, 30), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_set_int(&it, 5), 0); // next key after pop
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, 50), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 60), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_meta_set_bool(&it, true), 0); // after_map
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_bool(value.before_map, true);
+    test_bool(value.after_map, true);
+
+    test_assert(value.ints != NULL);
+    test_int(ecs_map_count(value.ints), 2);
+    test_int(*ecs_map_get(value.ints, int32_t, 1), 10);
+    test_int(*ecs_map_get(value.ints, int32_t, 2), 20);
+
+    test_assert(value.points != NULL);
+    test_int(ecs_map_count(value.points), 2);
+    Point *p = ecs_map_get(value.points, Point, 3);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    p = ecs_map_get(value.points, Point, 5);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+
+    ecs_map_free(value.ints);
+    ecs_map_free(value.points);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_string_arena() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Primitives);
+
+    char buf[16];
+    ecs_meta_arena_t arena;
+    ecs_meta_arena_init(&arena, buf, sizeof(buf));
+
+    Primitives value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Primitives), &value);
+    it.arena = &arena;
+    
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "str"), 0);
+    test_int(ecs_meta_set_string(&it, "Hello"), 0);
+    test_assert(value.str == buf);
+
+    /* Does not fit in buffer, is allocated from heap block of arena */
+    test_int(ecs_meta_set_string(&it, "Hello World, this is a long string"), 0);
+    test_str(value.str, "Hello World, this is a long string");
+    test_int(ecs_meta_pop(&it), 0);
+
+    ecs_meta_arena_reset(&arena);
+    test_int(arena.used, 0);
+
+    ecs_meta_arena_fini(&arena);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_cursor_reset() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    Line values[3] = {{{ 0 }}};
+    ecs_meta_cursor_t it = ecs_meta_cursor(world, ecs_entity(Line), &values[0]);
+
+    int32_t i;
+    for (i = 0; i < 3; i ++) {
+        if (i) {
+            ecs_meta_cursor_reset(&it, &values[i]);
+        }
+
+        test_int(ecs_meta_push(&it), 0);
+        test_int(ecs_meta_move_name(&it, "stop"), 0);
+        test_int(ecs_meta_push(&it), 0);
+        test_int(ecs_meta_set_int(&it, i + 1), 0);
+        test_int(ecs_meta_next(&it), 0);
+        test_int(ecs_meta_set_int(&it, i + 2), 0);
+        test_int(ecs_meta_pop(&it), 0);
+        test_int(ecs_meta_pop(&it), 0);
+        test_int(it.depth, 0);
+    }
+
+    for (i = 0; i < 3; i ++) {
+        test_int(values[i].start.x, 0);
+        test_int(values[i].start.y, 0);
+        test_int(values[i].stop.x, i + 1);
+        test_int(values[i].stop.y, i + 2);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_compact_cursor() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    /* One scope for the value, one for Line and one for Point */
+    ecs_size_t size = ecs_meta_cursor_size(world, ecs_entity(Line));
+    test_assert(size < ECS_SIZEOF(ecs_meta_cursor_t));
+
+    ecs_meta_cursor_t *it = ecs_os_malloc(size);
+
+    Line value = {{ 0 }};
+    test_assert(ecs_meta_cursor_init(
+        it, world, ecs_entity(Line), &value) == it);
+    test_int(it->max_depth, 3);
+
+    test_int(ecs_meta_push(it), 0);
+    test_int(ecs_meta_push(it), 0);
+    test_int(ecs_meta_set_int(it, 11), 0);
+    test_int(ecs_meta_next(it), 0);
+    test_int(ecs_meta_set_int(it, 22), 0);
+    test_int(ecs_meta_pop(it), 0);
+    test_int(ecs_meta_next(it), 0);
+    test_int(ecs_meta_push(it), 0);
+    test_int(ecs_meta_set_int(it, 33), 0);
+
+    /* Point has no nested scopes */
+    test_assert(ecs_meta_push(it) != 0);
+
+    test_int(ecs_meta_next(it), 0);
+    test_int(ecs_meta_set_int(it, 44), 0);
+    test_int(ecs_meta_pop(it), 0);
+    test_int(ecs_meta_pop(it), 0);
+
+    test_int(value.start.x, 11);
+    test_int(value.start.y, 22);
+    test_int(value.stop.x, 33);
+    test_int(value.stop.y, 44);
+
+    ecs_os_free(it);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_string_arena_reset() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Primitives);
+
+    ecs_meta_arena_t arena;
+    ecs_meta_arena_init(&arena, NULL, 0);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        /* Strings of the previous decode dangle after a reset */
+        Primitives value = { 0 };
+        ecs_meta_cursor_t it = ecs_meta_cursor(
+            world, ecs_entity(Primitives), &value);
+        it.arena = &arena;
+
+        test_int(ecs_meta_push(&it), 0);
+        test_int(ecs_meta_move_name(&it, "str"), 0);
+        test_int(ecs_meta_set_string(&it, "Hello"), 0);
+        test_int(ecs_meta_set_string(&it, "World"), 0);
+        test_int(ecs_meta_set_null(&it), 0);
+        test_int(ecs_meta_set_string(&it, "Foo"), 0);
+        test_int(ecs_meta_pop(&it), 0);
+
+        test_str(value.str, "Foo");
+        test_assert(ecs_meta_arena_owns(&arena, value.str));
+
+        /* Copy into component storage owns its strings */
+        ecs_entity_t e = ecs_set_ptr(world, 0, Primitives, &value);
+        const Primitives *ptr = ecs_get(world, e, Primitives);
+        test_assert(ptr != NULL);
+        test_str(ptr->str, "Foo");
+        test_assert(!ecs_meta_arena_owns(&arena, ptr->str));
+
+        ecs_meta_arena_reset(&arena);
+        test_int(arena.used, 0);
+    }
+
+    ecs_meta_arena_fini(&arena);
+
+    ecs_fini(world);
+}
+
+ECS_BITMASK(HighBits, {
+    Low = 1,
+    High = -2147483648,
+    LowHigh = 0x80000001
+});
+
+void Struct_struct_w_bitmask_high_bit() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, HighBits);
+
+    uint32_t value = 0;
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(HighBits), &value);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "High"), 0);
+    test_assert(value == 0x80000000);
+
+    test_int(ecs_meta_set_bitmask_names(&it, " Low |\tHigh "), 0);
+    test_assert(value == 0x80000001);
+
+    test_int(ecs_meta_set_bitmask_names(&it, "LowHigh"), 0);
+    test_assert(value == 0x80000001);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_w_map_negative_key() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Struct_w_map);
+
+    Struct_w_map value = { 0 };
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_map), &value);
+
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "ints"), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, -1), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 10), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    /* Key is sign extended, as if the int32_t was passed to ecs_map_get */
+    int32_t key = -1;
+    int32_t *v = ecs_map_get(value.ints, int32_t, key);
+    test_assert(v != NULL);
+    test_int(*v, 10);
+
+    ecs_map_free(value.ints);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Struct_w_string_map, {
+    ecs_map(int32_t, ecs_string_t) strings;
+});
+
+void Struct_map_string_reset() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Struct_w_string_map);
+
+    Struct_w_string_map value = { 0 };
+
+    int i;
+    for (i = 0; i < 2; i ++) {
+        /* Strings of the previous map elements are released on push */
+        ecs_meta_cursor_t it = ecs_meta_cursor(
+            world, ecs_entity(Struct_w_string_map), &value);
+        test_int(ecs_meta_push(&it), 0);
+        test_int(ecs_meta_push(&it), 0);
+        test_int(ecs_meta_set_int(&it, 1), 0);
+        test_int(ecs_meta_next(&it), 0);
+        test_int(ecs_meta_set_string(&it, "Hello"), 0);
+        test_int(ecs_meta_next(&it), 0);
+        test_int(ecs_meta_set_int(&it, 2), 0);
+        test_int(ecs_meta_next(&it), 0);
+        test_int(ecs_meta_set_string(&it, "World"), 0);
+        test_int(ecs_meta_pop(&it), 0);
+        test_int(ecs_meta_pop(&it), 0);
+
+        test_int(ecs_map_count(value.strings), 2);
+        test_str(*ecs_map_get(value.strings, char*, 1), "Hello");
+        test_str(*ecs_map_get(value.strings, char*, 2), "World");
+    }
+
+    ecs_os_free(*ecs_map_get(value.strings, char*, 1));
+    ecs_os_free(*ecs_map_get(value.strings, char*, 2));
+    ecs_map_free(value.strings);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Struct_w_string_vector, {
+    ecs_vector(ecs_string_t) strings;
+});
+
+void Struct_map_string_set_null() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Struct_w_string_map);
+
+    Struct_w_string_map value = { 0 };
+
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_string_map), &value);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, 1), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_string(&it, "Hello"), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 2), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_string(&it, "World"), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_map_count(value.strings), 2);
+
+    /* Strings of the map elements are released with the map */
+    it = ecs_meta_cursor(world, ecs_entity(Struct_w_string_map), &value);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_null(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_assert(value.strings == NULL);
+
+    ecs_fini(world);
+}
+
+void Struct_vector_string_set_null() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Struct_w_string_vector);
+
+    Struct_w_string_vector value = { 0 };
+
+    ecs_meta_cursor_t it = ecs_meta_cursor(
+        world, ecs_entity(Struct_w_string_vector), &value);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_string(&it, "Hello"), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_string(&it, "World"), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(ecs_vector_count(value.strings), 2);
+
+    /* Strings of the vector elements are released with the vector */
+    it = ecs_meta_cursor(world, ecs_entity(Struct_w_string_vector), &value);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_null(&it), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_assert(value.strings == NULL);
+
+    ecs_fini(world);
+}
@@ -28,6 +28,35 @@ void Struct_struct_reassign_vector(void);
 void Struct_struct_reassign_smaller_vector(void);
 void Struct_struct_reassign_larger_vector(void);
 void Struct_struct_reassign_vector_null(void);
+void Struct_struct_w_enum_by_name(void);
+void Struct_struct_w_enum_invalid_name(void);
+void Struct_struct_w_bitmask_by_name(void);
+void Struct_struct_move_name_invalid(void);
+void Struct_struct_w_vector_set_int_array(void);
+void Struct_struct_w_array_set_int_array_invalid(void);
+void Struct_struct_w_map(void);
+void Struct_struct_string_arena(void);
+void Struct_struct_cursor_reset(void);
+void Struct_struct_compact_cursor(void);
+void Struct_struct_string_arena_reset(void);
+void Struct_struct_w_bitmask_high_bit(void);
+void Struct_struct_w_map_negative_key(void);
+void Struct_map_string_reset(void);
+void Struct_map_string_set_null(void);
+void Struct_vector_string_set_null(void);
+
+// Testsuite 'FromStr'
+void FromStr_struct(void);
+void FromStr_nested_struct(void);
+void FromStr_primitives(void);
+void FromStr_string_escape(void);
+void FromStr_enum_bitmask(void);
+void FromStr_collections(void);
+void FromStr_round_trip(void);
+void FromStr_invalid(void);
+void FromStr_reader_chunks(void);
+void FromStr_reader_invalid(void);
+void FromStr_double_round_trip(void);
 
 bake_test_case Struct_testcases[] = {
     {
@@ -105,6 +134,117 @@ bake_test_case Struct_testcases[] = {
     {
         "struct_reassign_vector_null",
         Struct_struct_reassign_vector_null
+    },
+    {
+        "struct_w_enum_by_name",
+        Struct_struct_w_enum_by_name
+    },
+    {
+        "struct_w_enum_invalid_name",
+        Struct_struct_w_enum_invalid_name
+    },
+    {
+        "struct_w_bitmask_by_name",
+        Struct_struct_w_bitmask_by_name
+    },
+    {
+        "struct_move_name_invalid",
+        Struct_struct_move_name_invalid
+    },
+    {
+        "struct_w_vector_set_int_array",
+        Struct_struct_w_vector_set_int_array
+    },
+    {
+        "struct_w_array_set_int_array_invalid",
+        Struct_struct_w_array_set_int_array_invalid
+    },
+    {
+        "struct_w_map",
+        Struct_struct_w_map
+    },
+    {
+        "struct_string_arena",
+        Struct_struct_string_arena
+    },
+    {
+        "struct_cursor_reset",
+        Struct_struct_cursor_reset
+    },
+    {
+        "struct_compact_cursor",
+        Struct_struct_compact_cursor
+    },
+    {
+        "struct_string_arena_reset",
+        Struct_struct_string_arena_reset
+    },
+    {
+        "struct_w_bitmask_high_bit",
+        Struct_struct_w_bitmask_high_bit
+    },
+    {
+        "struct_w_map_negative_key",
+        Struct_struct_w_map_negative_key
+    },
+    {
+        "map_string_reset",
+        Struct_map_string_reset
+    },
+    {
+        "map_string_set_null",
+        Struct_map_string_set_null
+    },
+    {
+        "vector_string_set_null",
+        Struct_vector_string_set_null
+    }
+};
+
+bake_test_case FromStr_testcases[] = {
+    {
+        "struct",
+        FromStr_struct
+    },
+    {
+        "nested_struct",
+        FromStr_nested_struct
+    },
+    {
+        "primitives",
+        FromStr_primitives
+    },
+    {
+        "string_escape",
+        FromStr_string_escape
+    },
+    {
+        "enum_bitmask",
+        FromStr_enum_bitmask
+    },
+    {
+        "collections",
+        FromStr_collections
+    },
+    {
+        "round_trip",
+        FromStr_round_trip
+    },
+    {
+        "invalid",
+        FromStr_invalid
+    },
+    {
+        "reader_chunks",
+        FromStr_reader_chunks
+    },
+    {
+        "reader_invalid",
+        FromStr_reader_invalid
+    },
+    {
+        "double_round_trip",
+        FromStr_double_round_trip
     }
 };
 
@@ -113,12 +253,19 @@ static bake_test_suite suites[] = {
         "Struct",
         NULL,
         NULL,
-        19,
+        35,
         Struct_testcases
+    },
+    {
+        "FromStr",
+        NULL,
+        NULL,
+        11,
+        FromStr_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
     ut_init(argv[0]);
-    return bake_test_run("test", argc, argv, suites, 1);
+    return bake_test_run("test", argc, argv, suites, 2);
 }
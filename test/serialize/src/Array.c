@@ -240,3 +240,29 @@ void Array_array_array_nested_struct() {
 
     ecs_fini(world);
 }
+
+void Array_struct_array_int_size() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, ArrayInt);
+    ECS_META(world, Struct_w_array);
+
+    const EcsMetaType *type = ecs_get(world, ecs_entity(ArrayInt), EcsMetaType);
+    test_assert(type != NULL);
+    test_int(type->size, sizeof(ArrayInt));
+
+    type = ecs_get(world, ecs_entity(Struct_w_array), EcsMetaType);
+    test_assert(type != NULL);
+    test_int(type->size, sizeof(Struct_w_array));
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Struct_w_array), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+    test_int(ops[0].size, sizeof(Struct_w_array));
+
+    ecs_fini(world);
+}
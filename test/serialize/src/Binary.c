@@ -0,0 +1,402 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(BoolInt, {
+    bool a;
+    int32_t b;
+});
+
+ECS_STRUCT(Named, {
+    char *name;
+    int32_t value;
+});
+
+ECS_VECTOR(VectorInt, int32_t);
+ECS_VECTOR(VectorString, ecs_string_t);
+
+ECS_STRUCT(Polygon, {
+    char *name;
+    ecs_vector(Point) points;
+});
+
+ECS_MAP(MapIntString, int32_t, char*);
+
+void Binary_i32() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ecs_entity_t ecs_entity(int32_t) = ecs_lookup_fullpath(world, "flecs.core.int32_t");
+    test_assert(ecs_entity(int32_t) != 0);
+
+    {
+    ecs_vector_t *buf = NULL;
+    int32_t value = 0x01020304;
+    test_int(ecs_meta_to_binary(world, ecs_entity(int32_t), &value, &buf), 0);
+    test_int(ecs_vector_count(buf), 4);
+
+    uint8_t *bytes = ecs_vector_first(buf, uint8_t);
+    test_int(bytes[0], 0x04);
+    test_int(bytes[1], 0x03);
+    test_int(bytes[2], 0x02);
+    test_int(bytes[3], 0x01);
+
+    int32_t result = 0;
+    test_int(ecs_meta_from_binary(
+        world, ecs_entity(int32_t), &result, bytes, 4), 4);
+    test_int(result, 0x01020304);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Point value = {10, 20};
+    test_int(ecs_meta_to_binary(world, ecs_entity(Point), &value, &buf), 0);
+    test_int(ecs_vector_count(buf), 8);
+
+    Point result = {0};
+    test_int(ecs_meta_from_binary(world, ecs_entity(Point), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)), 8);
+    test_int(result.x, 10);
+    test_int(result.y, 20);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_struct_w_padding() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, BoolInt);
+
+    {
+    ecs_vector_t *buf = NULL;
+    BoolInt value = {true, 10};
+    test_int(ecs_meta_to_binary(world, ecs_entity(BoolInt), &value, &buf), 0);
+
+    /* Padding is not encoded */
+    test_int(ecs_vector_count(buf), 5);
+
+    BoolInt result = {0};
+    test_int(ecs_meta_from_binary(world, ecs_entity(BoolInt), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)), 5);
+    test_bool(result.a, true);
+    test_int(result.b, 10);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_struct_w_string() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Named);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Named value = {"Hello", 10};
+    test_int(ecs_meta_to_binary(world, ecs_entity(Named), &value, &buf), 0);
+
+    Named result = {0};
+    test_int(ecs_meta_from_binary(world, ecs_entity(Named), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+            ecs_vector_count(buf));
+    test_str(result.name, "Hello");
+    test_int(result.value, 10);
+    ecs_os_free(result.name);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_null_string() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Named);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Named value = {NULL, 10};
+    test_int(ecs_meta_to_binary(world, ecs_entity(Named), &value, &buf), 0);
+
+    Named result = {ecs_os_strdup("Hello"), 0};
+    test_int(ecs_meta_from_binary(world, ecs_entity(Named), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+            ecs_vector_count(buf));
+    test_assert(result.name == NULL);
+    test_int(result.value, 10);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_vector_int() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, VectorInt);
+
+    {
+    ecs_vector_t *buf = NULL;
+    ecs_vector_t *value = ecs_vector_from_array(
+        int32_t, 3, ((int32_t[]){10, 20, 30}));
+    test_int(ecs_meta_to_binary(
+        world, ecs_entity(VectorInt), &value, &buf), 0);
+    test_int(ecs_vector_count(buf), 16);
+
+    ecs_vector_t *result = NULL;
+    test_int(ecs_meta_from_binary(world, ecs_entity(VectorInt), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)), 16);
+    test_int(ecs_vector_count(result), 3);
+
+    int32_t *elems = ecs_vector_first(result, int32_t);
+    test_int(elems[0], 10);
+    test_int(elems[1], 20);
+    test_int(elems[2], 30);
+    ecs_vector_free(result);
+    ecs_vector_free(value);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_vector_string() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, VectorString);
+
+    {
+    ecs_vector_t *buf = NULL;
+    ecs_vector_t *value = ecs_vector_from_array(
+        char*, 2, ((char*[]){"Hello", "World"}));
+    test_int(ecs_meta_to_binary(
+        world, ecs_entity(VectorString), &value, &buf), 0);
+
+    ecs_vector_t *result = NULL;
+    test_int(ecs_meta_from_binary(world, ecs_entity(VectorString), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+            ecs_vector_count(buf));
+    test_int(ecs_vector_count(result), 2);
+
+    char **elems = ecs_vector_first(result, char*);
+    test_str(elems[0], "Hello");
+    test_str(elems[1], "World");
+    ecs_os_free(elems[0]);
+    ecs_os_free(elems[1]);
+    ecs_vector_free(result);
+    ecs_vector_free(value);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_struct_w_vector() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Polygon);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Polygon value = {"Square", ecs_vector_from_array(
+        Point, 2, ((Point[]){{10, 20}, {30, 40}}))};
+    test_int(ecs_meta_to_binary(
+        world, ecs_entity(Polygon), &value, &buf), 0);
+
+    Polygon result = {0};
+    test_int(ecs_meta_from_binary(world, ecs_entity(Polygon), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+            ecs_vector_count(buf));
+    test_str(result.name, "Square");
+    test_int(ecs_vector_count(result.points), 2);
+
+    Point *points = ecs_vector_first(result.points, Point);
+    test_int(points[0].x, 10);
+    test_int(points[0].y, 20);
+    test_int(points[1].x, 30);
+    test_int(points[1].y, 40);
+    ecs_os_free(result.name);
+    ecs_vector_free(result.points);
+    ecs_vector_free(value.points);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_map_int_string() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, MapIntString);
+
+    {
+    ecs_vector_t *buf = NULL;
+    ecs_map_t *value = ecs_map_new(char*, 0);
+    ecs_map_set(value, 1, &(char*){"Hello"});
+    ecs_map_set(value, 2, &(char*){"World"});
+    test_int(ecs_meta_to_binary(
+        world, ecs_entity(MapIntString), &value, &buf), 0);
+
+    ecs_map_t *result = NULL;
+    test_int(ecs_meta_from_binary(world, ecs_entity(MapIntString), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+            ecs_vector_count(buf));
+    test_int(ecs_map_count(result), 2);
+
+    char **str = ecs_map_get(result, char*, 1);
+    test_assert(str != NULL);
+    test_str(*str, "Hello");
+    ecs_os_free(*str);
+
+    str = ecs_map_get(result, char*, 2);
+    test_assert(str != NULL);
+    test_str(*str, "World");
+    ecs_os_free(*str);
+
+    ecs_map_free(result);
+    ecs_map_free(value);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_truncated() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, VectorInt);
+
+    {
+    ecs_vector_t *buf = NULL;
+    ecs_vector_t *value = ecs_vector_from_array(
+        int32_t, 3, ((int32_t[]){10, 20, 30}));
+    test_int(ecs_meta_to_binary(
+        world, ecs_entity(VectorInt), &value, &buf), 0);
+
+    ecs_vector_t *result = NULL;
+    test_int(ecs_meta_from_binary(world, ecs_entity(VectorInt), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf) - 1), -1);
+    ecs_vector_free(result);
+    ecs_vector_free(value);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_trusted() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Named);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Named value = {"Hello", 10};
+    test_int(ecs_meta_to_binary(world, ecs_entity(Named), &value, &buf), 0);
+
+    Named result = {0};
+    test_int(ecs_meta_from_binary_trusted(world, ecs_entity(Named), &result,
+        ecs_vector_first(buf, uint8_t)), ecs_vector_count(buf));
+    test_str(result.name, "Hello");
+    test_int(result.value, 10);
+    ecs_os_free(result.name);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_view() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, BoolInt);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Point value = {10, 20};
+    test_int(ecs_meta_to_binary(world, ecs_entity(Point), &value, &buf), 0);
+
+    const Point *ptr = ecs_meta_binary_view(world, ecs_entity(Point),
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf));
+    test_assert(ptr != NULL);
+    test_int(ptr->x, 10);
+    test_int(ptr->y, 20);
+    ecs_vector_free(buf);
+    }
+
+    {
+    ecs_vector_t *buf = NULL;
+    BoolInt value = {true, 10};
+    test_int(ecs_meta_to_binary(world, ecs_entity(BoolInt), &value, &buf), 0);
+
+    /* Type has padding, encoding is not the same as memory layout */
+    test_assert(ecs_meta_binary_view(world, ecs_entity(BoolInt),
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)) == NULL);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Binary_vector_count_too_large() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Polygon);
+
+    {
+    /* Null name followed by a count of ~1M points, while the input only has
+     * room for a single point */
+    uint8_t data[] = {
+        0xff, 0xff, 0xff, 0xff, 0x0, 0x0, 0x10, 0x0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    Polygon result = {NULL, NULL};
+    test_int(ecs_meta_from_binary(world, ecs_entity(Polygon), &result,
+        data, ECS_SIZEOF(data)), -1);
+    test_assert(result.points == NULL);
+    }
+
+    ecs_fini(world);
+}
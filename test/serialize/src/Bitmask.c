@@ -50,7 +50,7 @@ void Bitmask_bitmask_3() {
     {
     Toppings value = Bacon | Lettuce | Tomato;
     char *str = ecs_ptr_to_str(world, ecs_entity(Toppings), &value);
-    test_str(str, "Tomato | Bacon | Lettuce");
+    test_str(str, "Bacon | Lettuce | Tomato");
     ecs_os_free(str);
     }    
 
@@ -73,3 +73,43 @@ void Bitmask_bitmask_0_value() {
 
     ecs_fini(world);
 }
+
+ECS_BITMASK(Sandwich, {
+    Bread = 1,
+    Butter = 2,
+    Ham = 4,
+    Cheese = 8,
+    Toast = 3,
+    Club = 15
+});
+
+void Bitmask_bitmask_compound() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Sandwich);
+
+    {
+    Sandwich value = Bread | Butter | Cheese;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sandwich), &value);
+    test_str(str, "Toast | Cheese");
+    ecs_os_free(str);
+    }
+
+    {
+    Sandwich value = Bread | Butter | Ham | Cheese;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sandwich), &value);
+    test_str(str, "Club");
+    ecs_os_free(str);
+    }
+
+    {
+    Sandwich value = Butter | Ham;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sandwich), &value);
+    test_str(str, "Butter | Ham");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
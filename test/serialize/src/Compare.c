@@ -0,0 +1,192 @@
+#include <test.h>
+#include <math.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Padded, {
+    int8_t a;
+    int32_t b;
+});
+
+ECS_ARRAY(ArrayPadded, Padded, 2);
+
+ECS_STRUCT(Named, {
+    char *name;
+    ecs_vector(Point) points;
+});
+
+ECS_STRUCT(Floats, {
+    float f32;
+    double f64;
+});
+
+void Compare_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    Point a = {10, 20}, b = {10, 20}, c = {10, 30};
+    test_bool(ecs_meta_equals(world, ecs_entity(Point), &a, &b), true);
+    test_bool(ecs_meta_equals(world, ecs_entity(Point), &a, &c), false);
+    test_assert(ecs_meta_hash(world, ecs_entity(Point), &a) == 
+        ecs_meta_hash(world, ecs_entity(Point), &b));
+
+    ecs_fini(world);
+}
+
+void Compare_padded_array() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Padded);
+    ECS_META(world, ArrayPadded);
+
+    /* Values only differ in padding bytes */
+    Padded a[2], b[2];
+    memset(a, 0, sizeof(a));
+    memset(b, 0xff, sizeof(b));
+    a[0].a = b[0].a = 1;
+    a[0].b = b[0].b = 2;
+    a[1].a = b[1].a = 3;
+    a[1].b = b[1].b = 4;
+
+    test_bool(ecs_meta_equals(world, ecs_entity(ArrayPadded), a, b), true);
+    test_assert(ecs_meta_hash(world, ecs_entity(ArrayPadded), a) == 
+        ecs_meta_hash(world, ecs_entity(ArrayPadded), b));
+
+    bool result[2];
+    test_int(ecs_meta_equals_n(
+        world, ecs_entity(Padded), a, b, 2, result), 2);
+
+    b[1].b = 5;
+    test_bool(ecs_meta_equals(world, ecs_entity(ArrayPadded), a, b), false);
+    test_int(ecs_meta_equals_n(
+        world, ecs_entity(Padded), a, b, 2, result), 1);
+    test_bool(result[0], true);
+    test_bool(result[1], false);
+
+    ecs_fini(world);
+}
+
+void Compare_string_vector() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Named);
+
+    /* Strings and vectors are compared by value, not by pointer */
+    char name_a[] = "Foo", name_b[] = "Foo";
+    Named a = { name_a, NULL }, b = { name_b, NULL };
+    Point *p = ecs_vector_add(&a.points, Point);
+    *p = (Point){1, 2};
+    p = ecs_vector_add(&b.points, Point);
+    *p = (Point){1, 2};
+
+    test_bool(ecs_meta_equals(world, ecs_entity(Named), &a, &b), true);
+    test_assert(ecs_meta_hash(world, ecs_entity(Named), &a) == 
+        ecs_meta_hash(world, ecs_entity(Named), &b));
+
+    name_b[2] = 'x';
+    test_bool(ecs_meta_equals(world, ecs_entity(Named), &a, &b), false);
+    name_b[2] = 'o';
+
+    p = ecs_vector_add(&b.points, Point);
+    *p = (Point){3, 4};
+    test_bool(ecs_meta_equals(world, ecs_entity(Named), &a, &b), false);
+
+    b.name = NULL;
+    test_bool(ecs_meta_equals(world, ecs_entity(Named), &a, &b), false);
+
+    ecs_vector_free(a.points);
+    ecs_vector_free(b.points);
+
+    ecs_fini(world);
+}
+
+void Compare_float_zero() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Floats);
+
+    Floats a = {0.0f, 0.0}, b = {-0.0f, -0.0};
+    test_bool(ecs_meta_equals(world, ecs_entity(Floats), &a, &b), true);
+    test_assert(ecs_meta_hash(world, ecs_entity(Floats), &a) == 
+        ecs_meta_hash(world, ecs_entity(Floats), &b));
+
+    ecs_fini(world);
+}
+
+void Compare_float_nan() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Floats);
+
+    /* A NaN equals itself, but not a NaN with different bits */
+    Floats a = {NAN, 1.0}, b = {-NAN, 1.0}, c = {1.0f, 1.0};
+    test_bool(ecs_meta_equals(world, ecs_entity(Floats), &a, &a), true);
+    test_bool(ecs_meta_equals(world, ecs_entity(Floats), &a, &b), false);
+    test_bool(ecs_meta_equals(world, ecs_entity(Floats), &a, &c), false);
+
+    bool result;
+    test_int(ecs_meta_equals_n(
+        world, ecs_entity(Floats), &a, &a, 1, &result), 1);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Vec3, {
+    float x;
+    float y;
+    float z;
+});
+
+void Compare_float_column() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Vec3);
+
+    Vec3 a[3] = {{1, 2, 3}, {0.0f, 0.0f, 0.0f}, {4, 5, 6}};
+    Vec3 b[3] = {{1, 2, 3}, {0.0f, 0.0f, 0.0f}, {4, 5, 6}};
+    bool result[3];
+
+    /* Identical columns are equal with a single compare */
+    test_int(ecs_meta_equals_n(
+        world, ecs_entity(Vec3), a, b, 3, result), 3);
+    test_bool(result[0], true);
+    test_bool(result[1], true);
+    test_bool(result[2], true);
+
+    /* Otherwise floats are compared by value */
+    b[1].y = -0.0f;
+    b[2].z = 7;
+    test_int(ecs_meta_equals_n(
+        world, ecs_entity(Vec3), a, b, 3, result), 2);
+    test_bool(result[0], true);
+    test_bool(result[1], true);
+    test_bool(result[2], false);
+
+    test_assert(ecs_meta_hash(world, ecs_entity(Vec3), &a[1]) == 
+        ecs_meta_hash(world, ecs_entity(Vec3), &b[1]));
+
+    /* Floats are kept apart from blits when comparing */
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Vec3), EcsMetaTypeSerializer);
+    test_int(ecs_vector_count(ser->opt_ops), 2);
+    test_int(ecs_vector_count(ser->cmp_ops), 4);
+
+    ecs_fini(world);
+}
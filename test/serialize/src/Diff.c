@@ -0,0 +1,170 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Named, {
+    char *name;
+    int32_t value;
+});
+
+ECS_STRUCT(Polygon, {
+    char *name;
+    ecs_vector(Point) points;
+});
+
+void Diff_unchanged() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Point old_value = {10, 20};
+    Point new_value = {10, 20};
+    test_int(ecs_meta_diff(
+        world, ecs_entity(Point), &old_value, &new_value, &buf), 0);
+    test_int(ecs_vector_count(buf), 1);
+
+    Point result = {10, 20};
+    test_int(ecs_meta_patch(world, ecs_entity(Point), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)), 1);
+    test_int(result.x, 10);
+    test_int(result.y, 20);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Diff_single_member() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Point old_value = {10, 20};
+    Point new_value = {10, 30};
+    test_int(ecs_meta_diff(
+        world, ecs_entity(Point), &old_value, &new_value, &buf), 0);
+
+    /* Bitmask followed by the value of y */
+    test_int(ecs_vector_count(buf), 5);
+
+    Point result = {10, 20};
+    test_int(ecs_meta_patch(world, ecs_entity(Point), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)), 5);
+    test_int(result.x, 10);
+    test_int(result.y, 30);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Diff_string_member() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Named);
+
+    {
+    ecs_vector_t *buf = NULL;
+    Named old_value = {"Hello", 10};
+    Named new_value = {"World", 10};
+    test_int(ecs_meta_diff(
+        world, ecs_entity(Named), &old_value, &new_value, &buf), 0);
+
+    Named result = {ecs_os_strdup("Hello"), 10};
+    test_int(ecs_meta_patch(world, ecs_entity(Named), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+        ecs_vector_count(buf));
+    test_str(result.name, "World");
+    test_int(result.value, 10);
+    test_assert(ecs_meta_equals(
+        world, ecs_entity(Named), &result, &new_value));
+    ecs_os_free(result.name);
+    ecs_vector_free(buf);
+    }
+
+    ecs_fini(world);
+}
+
+void Diff_vector_member() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Polygon);
+
+    {
+    Polygon old_value = {"poly", ecs_vector_from_array(
+        Point, 2, ((Point[]){{1, 2}, {3, 4}}))};
+    Polygon grown = {"poly", ecs_vector_from_array(
+        Point, 3, ((Point[]){{1, 2}, {5, 6}, {7, 8}}))};
+    Polygon shrunk = {"poly", ecs_vector_from_array(
+        Point, 1, ((Point[]){{1, 2}}))};
+
+    Polygon result = {
+        ecs_os_strdup("poly"), ecs_vector_copy(old_value.points, Point)};
+
+    /* Changed and appended elements */
+    ecs_vector_t *buf = NULL;
+    test_int(ecs_meta_diff(
+        world, ecs_entity(Polygon), &old_value, &grown, &buf), 0);
+    test_int(ecs_meta_patch(world, ecs_entity(Polygon), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+        ecs_vector_count(buf));
+    test_assert(ecs_meta_equals(world, ecs_entity(Polygon), &result, &grown));
+    ecs_vector_free(buf);
+
+    /* Removed elements */
+    buf = NULL;
+    test_int(ecs_meta_diff(
+        world, ecs_entity(Polygon), &grown, &shrunk, &buf), 0);
+    test_int(ecs_meta_patch(world, ecs_entity(Polygon), &result,
+        ecs_vector_first(buf, uint8_t), ecs_vector_count(buf)),
+        ecs_vector_count(buf));
+    test_assert(ecs_meta_equals(world, ecs_entity(Polygon), &result, &shrunk));
+    ecs_vector_free(buf);
+
+    ecs_os_free(result.name);
+    ecs_vector_free(result.points);
+    ecs_vector_free(old_value.points);
+    ecs_vector_free(grown.points);
+    ecs_vector_free(shrunk.points);
+    }
+
+    ecs_fini(world);
+}
+
+void Diff_vector_count_too_large() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Polygon);
+
+    {
+    /* Only the points member changed, and the delta claims that ~1M points
+     * were appended while the input only has room for a few */
+    uint8_t delta[] = {0x2, 0x0, 0x0, 0x10, 0x0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    Polygon result = {NULL, NULL};
+    test_int(ecs_meta_patch(world, ecs_entity(Polygon), &result,
+        delta, ECS_SIZEOF(delta)), -1);
+    test_assert(result.points == NULL);
+    }
+
+    ecs_fini(world);
+}
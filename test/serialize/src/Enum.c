@@ -106,3 +106,40 @@ void Enum_enum_invalid_value() {
 
     ecs_fini(world);
 }
+
+ECS_ENUM(Sparse, {
+    Small = -100,
+    Medium = 1,
+    Large = 100000
+});
+
+void Enum_enum_sparse_values() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Sparse);
+
+    {
+    Sparse value = Small;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sparse), &value);
+    test_str(str, "Small");
+    ecs_os_free(str);
+    }
+
+    {
+    Sparse value = Large;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sparse), &value);
+    test_str(str, "Large");
+    ecs_os_free(str);
+    }
+
+    {
+    Sparse value = 2;
+    char *str = ecs_ptr_to_str(world, ecs_entity(Sparse), &value);
+    test_str(str, NULL);
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
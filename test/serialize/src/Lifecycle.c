@@ -0,0 +1,261 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Resources, {
+    char *name;
+    ecs_vector(Point) points;
+    ecs_map(int32_t, ecs_string_t) labels;
+});
+
+ECS_STRUCT(Plain, {
+    int32_t value;
+});
+
+ECS_STRUCT(Handle, {
+    uintptr_t value;
+});
+
+static
+Resources new_resources(
+    const char *name)
+{
+    Resources r = { .name = ecs_os_strdup(name) };
+    Point *p = ecs_vector_add(&r.points, Point);
+    *p = (Point){1, 2};
+
+    r.labels = ecs_map_new(char*, 1);
+    char *label = ecs_os_strdup("one");
+    ecs_map_set(r.labels, 1, &label);
+    return r;
+}
+
+void Lifecycle_copy() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Resources);
+
+    ecs_entity_t e = ecs_set_ptr(world, 0, Resources, 
+        &(Resources){ .name = "Foo" });
+    test_assert(e != 0);
+
+    /* Setting a value copies it, the original is not owned by the world */
+    const Resources *ptr = ecs_get(world, e, Resources);
+    test_assert(ptr != NULL);
+    test_str(ptr->name, "Foo");
+
+    Resources value = new_resources("Bar");
+    ecs_set_ptr(world, e, Resources, &value);
+
+    ptr = ecs_get(world, e, Resources);
+    test_str(ptr->name, "Bar");
+    test_assert(ptr->name != value.name);
+    test_assert(ptr->points != value.points);
+    test_assert(ptr->labels != value.labels);
+    test_int(ecs_vector_count(ptr->points), 1);
+
+    char **label = ecs_map_get(ptr->labels, char*, 1);
+    test_assert(label != NULL);
+    test_str(*label, "one");
+    test_assert(*label != *ecs_map_get(value.labels, char*, 1));
+
+    /* Clone copies the value */
+    ecs_entity_t clone = ecs_clone(world, 0, e, true);
+    const Resources *clone_ptr = ecs_get(world, clone, Resources);
+    test_assert(clone_ptr != NULL);
+    test_str(clone_ptr->name, "Bar");
+    test_assert(clone_ptr->name != ptr->name);
+
+    ecs_map_each(value.labels, char*, key, l, {
+        ecs_os_free(*l);
+    });
+
+    ecs_os_free(value.name);
+    ecs_vector_free(value.points);
+    ecs_map_free(value.labels);
+
+    ecs_fini(world);
+}
+
+void Lifecycle_move() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Resources);
+    ECS_META(world, Plain);
+
+    Resources value = new_resources("Foo");
+    ecs_entity_t e = ecs_set_ptr(world, 0, Resources, &value);
+
+    const Resources *ptr = ecs_get(world, e, Resources);
+    char *name = ptr->name;
+
+    /* Adding a component moves the value to another table */
+    ecs_add(world, e, Plain);
+
+    ptr = ecs_get(world, e, Resources);
+    test_assert(ptr != NULL);
+    test_assert(ptr->name == name);
+    test_str(ptr->name, "Foo");
+    test_int(ecs_vector_count(ptr->points), 1);
+    test_int(ecs_map_count(ptr->labels), 1);
+
+    ecs_map_each(value.labels, char*, key, l, {
+        ecs_os_free(*l);
+    });
+
+    ecs_os_free(value.name);
+    ecs_vector_free(value.points);
+    ecs_map_free(value.labels);
+
+    ecs_fini(world);
+}
+
+void Lifecycle_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Resources);
+
+    Resources value = new_resources("Foo");
+    ecs_entity_t e = ecs_set_ptr(world, 0, Resources, &value);
+    ecs_entity_t e2 = ecs_set_ptr(world, 0, Resources, &value);
+
+    ecs_delete(world, e);
+    test_assert(!ecs_get(world, e, Resources));
+
+    ecs_remove(world, e2, Resources);
+    test_assert(!ecs_get(world, e2, Resources));
+
+    ecs_map_each(value.labels, char*, key, l, {
+        ecs_os_free(*l);
+    });
+
+    ecs_os_free(value.name);
+    ecs_vector_free(value.points);
+    ecs_map_free(value.labels);
+
+    ecs_fini(world);
+}
+
+void Lifecycle_fini() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Resources);
+
+    Resources value = new_resources("Foo");
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_set_ptr(world, 0, Resources, &value);
+    }
+
+    ecs_map_each(value.labels, char*, key, l, {
+        ecs_os_free(*l);
+    });
+
+    ecs_os_free(value.name);
+    ecs_vector_free(value.points);
+    ecs_map_free(value.labels);
+
+    /* Values are released by ecs_fini, regardless of the order in which the
+     * component and its serializer are deleted */
+    ecs_fini(world);
+}
+
+void Lifecycle_redefine() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Handle);
+
+    ecs_entity_t e = ecs_set(world, 0, Handle, {0});
+
+    /* Type that didn't own resources now owns a string */
+    ecs_set(world, ecs_entity(Handle), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Handle),
+        .alignment = ECS_ALIGNOF(Handle),
+        .descriptor = "{char *name;}"
+    });
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Handle), EcsMetaTypeSerializer);
+    test_bool(ser->owns_heap, true);
+
+    /* Actions follow the new definition */
+    char *name = "Foo";
+    ecs_set(world, e, Handle, {(uintptr_t)name});
+    
+    const Handle *ptr = ecs_get(world, e, Handle);
+    test_assert(ptr->value != (uintptr_t)name);
+    test_str((char*)ptr->value, "Foo");
+
+    ecs_entity_t e2 = ecs_clone(world, 0, e, true);
+    const Handle *ptr2 = ecs_get(world, e2, Handle);
+    test_assert(ptr2->value != ptr->value);
+    test_str((char*)ptr2->value, "Foo");
+
+    ecs_fini(world);
+}
+
+void Lifecycle_world_context() {
+    ecs_world_t *world_1 = ecs_init();
+    ecs_world_t *world_2 = ecs_init();
+
+    int ctx_1, ctx_2;
+    ecs_set_context(world_1, &ctx_1);
+
+    {
+    ecs_world_t *world = world_1;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, Point);
+    }
+
+    {
+    ecs_world_t *world = world_2;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, Point);
+    }
+
+    ecs_set_context(world_2, &ctx_2);
+
+    /* The module does not use the world context */
+    test_assert(ecs_get_context(world_1) == &ctx_1);
+    test_assert(ecs_get_context(world_2) == &ctx_2);
+
+    Point value = {10, 20};
+
+    {
+    char *str = ecs_ptr_to_str(
+        world_1, ecs_lookup(world_1, "Point"), &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    /* Data of the other world is not affected by deleting a world */
+    ecs_fini(world_1);
+
+    {
+    char *str = ecs_ptr_to_str(
+        world_2, ecs_lookup(world_2, "Point"), &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world_2);
+}
@@ -0,0 +1,157 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Padded, {
+    int8_t a;
+    int32_t b;
+    int8_t c;
+});
+
+ECS_ARRAY(ArrayPoint, Point, 3);
+ECS_ARRAY(ArrayPadded, Padded, 3);
+
+ECS_STRUCT(Struct_w_padded_array, {
+    int32_t x;
+    ArrayPadded values;
+});
+
+void Optimizer_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Point), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    ecs_vector_t *ops = ser->opt_ops;
+    test_int(ecs_vector_count(ops), 2);
+
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    test_int(op[0].kind, EcsOpHeader);
+    test_int(op[1].kind, EcsOpBlit);
+    test_int(op[1].offset, 0);
+    test_int(op[1].size, sizeof(Point));
+
+    ecs_fini(world);
+}
+
+void Optimizer_padded_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Padded);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Padded), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    /* Padding ends a blit */
+    ecs_vector_t *ops = ser->opt_ops;
+    test_int(ecs_vector_count(ops), 3);
+
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    test_int(op[1].kind, EcsOpBlit);
+    test_int(op[1].offset, offsetof(Padded, a));
+    test_int(op[1].size, sizeof(int8_t));
+    test_int(op[2].kind, EcsOpBlit);
+    test_int(op[2].offset, offsetof(Padded, b));
+    test_int(op[2].size, sizeof(int32_t) + sizeof(int8_t));
+
+    ecs_fini(world);
+}
+
+void Optimizer_array_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, ArrayPoint);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(ArrayPoint), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    ecs_vector_t *ops = ser->opt_ops;
+    test_int(ecs_vector_count(ops), 2);
+
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    test_int(op[1].kind, EcsOpBlit);
+    test_int(op[1].size, sizeof(ArrayPoint));
+
+    ecs_fini(world);
+}
+
+void Optimizer_array_padded_struct() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Padded);
+    ECS_META(world, ArrayPadded);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(ArrayPadded), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    /* Array of padded elements must not be merged into a single blit */
+    ecs_vector_t *ops = ser->opt_ops;
+    test_int(ecs_vector_count(ops), 2);
+
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    test_int(op[1].kind, EcsOpArray);
+    test_int(op[1].count, 3);
+    test_int(op[1].size, sizeof(Padded));
+
+    ecs_fini(world);
+}
+
+void Optimizer_struct_w_padded_array() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Padded);
+    ECS_META(world, ArrayPadded);
+    ECS_META(world, Struct_w_padded_array);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Struct_w_padded_array), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    ecs_vector_t *ops = ser->opt_ops;
+    test_int(ecs_vector_count(ops), 3);
+
+    ecs_type_op_t *op = ecs_vector_first(ops, ecs_type_op_t);
+    test_int(op[1].kind, EcsOpBlit);
+    test_int(op[1].offset, offsetof(Struct_w_padded_array, x));
+    test_int(op[1].size, sizeof(int32_t));
+    test_int(op[2].kind, EcsOpArray);
+    test_int(op[2].offset, offsetof(Struct_w_padded_array, values));
+
+    /* Padded elements compare equal if only the padding differs */
+    Struct_w_padded_array a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0xff, sizeof(b));
+    b.x = 0;
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        b.values[i].a = 0;
+        b.values[i].b = 0;
+        b.values[i].c = 0;
+    }
+
+    test_assert(ecs_meta_equals(
+        world, ecs_entity(Struct_w_padded_array), &a, &b));
+
+    ecs_fini(world);
+}
@@ -0,0 +1,96 @@
+#include <test.h>
+
+ECS_STRUCT(DynamicArray, {
+    int32_t count;
+    int32_t values[];
+});
+
+ECS_STRUCT(DynamicArrayWSpace, {
+    int32_t count;
+    int32_t values[ ];
+});
+
+ECS_STRUCT(ArraySize1, {
+    int32_t values[1];
+});
+
+void Parser_setup() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.abort = test_abort;
+    ecs_os_set_api(&os_api);
+}
+
+void Parser_struct_dynamic_array() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_expect_abort();
+
+    ECS_META(world, DynamicArray);
+}
+
+void Parser_struct_dynamic_array_w_space() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_expect_abort();
+
+    ECS_META(world, DynamicArrayWSpace);
+}
+
+void Parser_struct_array_size_1() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, ArraySize1);
+
+    {
+    ArraySize1 value = {{10}};
+    char *str = ecs_ptr_to_str(world, ecs_entity(ArraySize1), &value);
+    test_str(str, "{values = [10]}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length, {
+    int32_t value;
+});
+
+ECS_STRUCT(LongIdentifiers, {
+    Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length;
+});
+
+void Parser_struct_long_identifiers() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    /* Identifiers are not limited to ECS_META_IDENTIFIER_LENGTH */
+    ECS_META(world, Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length_Type_name_longer_than_identifier_length);
+    ECS_META(world, LongIdentifiers);
+
+    const char *member =
+        "member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length";
+    test_assert(ecs_os_strlen(member) > 256);
+
+    {
+    LongIdentifiers value = {{0}};
+    ecs_meta_cursor_t cur = ecs_meta_cursor(
+        world, ecs_entity(LongIdentifiers), &value);
+    test_int(ecs_meta_push(&cur), 0);
+    test_int(ecs_meta_move_name(&cur, member), 0);
+    test_int(ecs_meta_push(&cur), 0);
+    test_int(ecs_meta_set_int(&cur, 10), 0);
+    test_int(ecs_meta_pop(&cur), 0);
+    test_int(ecs_meta_pop(&cur), 0);
+    test_int(value.member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length_member_name_longer_than_identifier_length.value, 10);
+    }
+
+    ecs_fini(world);
+}
@@ -467,28 +467,28 @@ void Primitive_float() {
     {
     float value = 0;
     char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
-    test_str(str, "0.000000");
+    test_str(str, "0.0");
     ecs_os_free(str);
     }
 
     {
     float value = 10;
     char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
-    test_str(str, "10.000000");
+    test_str(str, "10.0");
     ecs_os_free(str);
     }    
 
     {
     float value = 10.5;
     char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
-    test_str(str, "10.500000");
+    test_str(str, "10.5");
     ecs_os_free(str);
     }        
 
     {
     float value = -10.5;
     char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
-    test_str(str, "-10.500000");
+    test_str(str, "-10.5");
     ecs_os_free(str);
     }        
 
@@ -507,28 +507,28 @@ void Primitive_double() {
     {
     double value = 0;
     char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
-    test_str(str, "0.000000");
+    test_str(str, "0.0");
     ecs_os_free(str);
     }
 
     {
     double value = 10;
     char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
-    test_str(str, "10.000000");
+    test_str(str, "10.0");
     ecs_os_free(str);
     }    
 
     {
     double value = 10.5;
     char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
-    test_str(str, "10.500000");
+    test_str(str, "10.5");
     ecs_os_free(str);
     }   
 
     {
     double value = -10.5;
     char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
-    test_str(str, "-10.500000");
+    test_str(str, "-10.5");
     ecs_os_free(str);
     }            
 
@@ -598,3 +598,67 @@ void Primitive_entity() {
     
     ecs_fini(world);
 }
+
+void Primitive_float_shortest() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ecs_entity_t ecs_entity(float) = ecs_lookup_fullpath(world, "flecs.core.float");
+    test_assert(ecs_entity(float) != 0);
+
+    {
+    float value = 0.1f;
+    char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
+    test_str(str, "0.1");
+    ecs_os_free(str);
+    }
+
+    {
+    float value = 1e-7f;
+    char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
+    test_str(str, "1e-7");
+    ecs_os_free(str);
+    }
+
+    {
+    float value = 3.14159f;
+    char *str = ecs_ptr_to_str(world, ecs_entity(float), &value);
+    test_str(str, "3.14159");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Primitive_double_shortest() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ecs_entity_t ecs_entity(double) = ecs_lookup_fullpath(world, "flecs.core.double");
+    test_assert(ecs_entity(double) != 0);
+
+    {
+    double value = 0.1 + 0.2;
+    char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
+    test_str(str, "0.30000000000000004");
+    ecs_os_free(str);
+    }
+
+    {
+    double value = 1e21;
+    char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
+    test_str(str, "1e21");
+    ecs_os_free(str);
+    }
+
+    {
+    double value = 0.000001;
+    char *str = ecs_ptr_to_str(world, ecs_entity(double), &value);
+    test_str(str, "0.000001");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
@@ -0,0 +1,213 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(Polygon, {
+    char *name;
+    ecs_vector(Point) points;
+});
+
+ECS_ENUM(Color, {
+    Red, Green, Blue
+});
+
+ECS_STRUCT(Shape, {
+    Color color;
+    int32_t size[2];
+});
+
+static
+ecs_vector_t* save_registry(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Polygon);
+    ECS_META(world, Color);
+    ECS_META(world, Shape);
+
+    ecs_vector_t *result = NULL;
+    test_int(ecs_meta_save_registry(world, &result), 0);
+    test_assert(result != NULL);
+
+    ecs_fini(world);
+
+    return result;
+}
+
+void Registry_load() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), 0);
+
+    ecs_entity_t point = ecs_lookup_fullpath(world, "Point");
+    test_assert(point != 0);
+
+    Point p = {10, 20};
+    char *str = ecs_ptr_to_str(world, point, &p);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+
+    ecs_entity_t shape = ecs_lookup_fullpath(world, "Shape");
+    test_assert(shape != 0);
+
+    Shape s = {Blue, {1, 2}};
+    str = ecs_ptr_to_str(world, shape, &s);
+    test_str(str, "{color = Blue, size = [1, 2]}");
+    ecs_os_free(str);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
+
+void Registry_load_w_vector() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), 0);
+
+    ecs_entity_t polygon = ecs_lookup_fullpath(world, "Polygon");
+    test_assert(polygon != 0);
+
+    Polygon p = {"Line", ecs_vector_from_array(
+        Point, 2, ((Point[]){{10, 20}, {30, 40}}))};
+    char *str = ecs_ptr_to_str(world, polygon, &p);
+    test_str(str, "{name = \"Line\", points = [{x = 10, y = 20}, {x = 30, y = 40}]}");
+    ecs_os_free(str);
+    ecs_vector_free(p.points);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
+
+void Registry_meta_after_load() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), 0);
+
+    ecs_entity_t point = ecs_lookup_fullpath(world, "Point");
+    test_assert(point != 0);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, point, EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    ecs_vector_t *ops = ser->ops;
+
+    /* Definition did not change, so loaded type is not parsed again */
+    ECS_META(world, Point);
+    test_assert(ecs_entity(Point) == point);
+
+    ser = ecs_get(world, point, EcsMetaTypeSerializer);
+    test_assert(ser->ops == ops);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
+
+void Registry_load_invalid() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    /* Corrupt last byte of payload */
+    uint8_t *last = ecs_vector_last(snapshot, uint8_t);
+    (*last) ++;
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), -1);
+    test_assert(ecs_lookup_fullpath(world, "Point") == 0);
+
+    /* Truncated */
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), 8), -1);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
+
+void Registry_load_conflict() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    /* Register type with same name but different definition */
+    ecs_entity_t point = ecs_new_component(
+        world, 0, "Point", sizeof(int32_t), ECS_ALIGNOF(int32_t));
+    ecs_set(world, point, EcsMetaType, {
+        EcsStructType, 0, 0, "{int32_t x;}", NULL});
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), -1);
+    test_assert(ecs_lookup_fullpath(world, "Polygon") == 0);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
+
+void Registry_load_members() {
+    ecs_vector_t *snapshot = save_registry();
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    test_int(ecs_meta_load_registry(world, 
+        ecs_vector_first(snapshot, uint8_t), ecs_vector_count(snapshot)), 0);
+
+    ecs_entity_t shape = ecs_lookup_fullpath(world, "Shape");
+    test_assert(shape != 0);
+
+    /* Loaded serializers have the same member index as parsed ones */
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, shape, EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_assert(ser->members != NULL);
+
+    Shape s = {Red, {0, 0}};
+    ecs_meta_cursor_t it = ecs_meta_cursor(world, shape, &s);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_move_name(&it, "size"), 0);
+    test_int(ecs_meta_push(&it), 0);
+    test_int(ecs_meta_set_int(&it, 10), 0);
+    test_int(ecs_meta_next(&it), 0);
+    test_int(ecs_meta_set_int(&it, 20), 0);
+    test_int(ecs_meta_pop(&it), 0);
+    test_int(ecs_meta_move_name(&it, "color"), 0);
+    test_int(ecs_meta_set_enum_name(&it, "Green"), 0);
+    test_int(ecs_meta_pop(&it), 0);
+
+    test_int(s.color, Green);
+    test_int(s.size[0], 10);
+    test_int(s.size[1], 20);
+
+    ecs_fini(world);
+
+    ecs_vector_free(snapshot);
+}
@@ -20,6 +20,15 @@ ECS_STRUCT(i32_bool, {
     bool b;
 });
 
+ECS_STRUCT(Target, {
+    ecs_entity_t entity;
+});
+
+ECS_STRUCT(Underscore, {
+    int32_t _x;
+    int32_t __y;
+});
+
 void Struct_struct() {
     ecs_world_t *world = ecs_init();
 
@@ -88,3 +97,449 @@ void Struct_struct_i32_bool() {
 
     ecs_fini(world);
 }
+
+void Struct_struct_array_to_str() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    Point value[] = {{10, 20}, {30, 40}};
+    char *str = ecs_array_to_str(world, ecs_entity(Point), value, 2);
+    test_str(str, "[{x = 10, y = 20}, {x = 30, y = 40}]");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_iter_to_str() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    ecs_entity_t e1 = ecs_set(world, 0, EcsName, {"e1"});
+    ecs_set(world, e1, Point, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, EcsName, {"e2"});
+    ecs_set(world, e2, Point, {30, 40});
+
+    ecs_filter_t filter = {
+        .include = ecs_type(Point)
+    };
+
+    ecs_iter_t it = ecs_filter_iter(world, &filter);
+    test_assert(ecs_filter_next(&it));
+    test_int(it.count, 2);
+
+    char *str = ecs_iter_to_str(&it);
+    test_str(str, 
+        "e1: {\n"
+        "    Point: {x = 10, y = 20}\n"
+        "}\n"
+        "e2: {\n"
+        "    Point: {x = 30, y = 40}\n"
+        "}");
+    ecs_os_free(str);
+
+    test_assert(!ecs_filter_next(&it));
+
+    ecs_fini(world);
+}
+
+void Struct_struct_redefine() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    Point value = {10, 20};
+
+    {
+    char *str = ecs_ptr_to_str(world, ecs_entity(Point), &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_set(world, ecs_entity(Point), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Point),
+        .alignment = ECS_ALIGNOF(Point),
+        .descriptor = "{int32_t a; int32_t b;}"
+    });
+
+    {
+    char *str = ecs_ptr_to_str(world, ecs_entity(Point), &value);
+    test_str(str, "{a = 10, b = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_two_worlds() {
+    ecs_world_t *world_1 = ecs_init();
+    ecs_world_t *world_2 = ecs_init();
+
+    {
+    ecs_world_t *world = world_1;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, Point);
+    }
+
+    {
+    ecs_world_t *world = world_2;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, bool_i32);
+    ECS_META(world, Point);
+    }
+
+    Point value = {10, 20};
+
+    ecs_entity_t point_1 = ecs_lookup(world_1, "Point");
+    ecs_entity_t point_2 = ecs_lookup(world_2, "Point");
+    test_assert(point_1 != 0);
+    test_assert(point_2 != 0);
+
+    {
+    char *str = ecs_ptr_to_str(world_1, point_1, &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    {
+    char *str = ecs_ptr_to_str(world_2, point_2, &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world_1);
+    ecs_fini(world_2);
+}
+
+ECS_STRUCT(Mesh, {
+    int32_t position[3];
+    ecs_vector(ecs_entity_t) children;
+});
+
+ECS_STRUCT(Camera, {
+    int32_t position[3];
+    ecs_vector(ecs_entity_t) children;
+});
+
+void Struct_struct_shared_collection_types() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Mesh);
+    ECS_META(world, Camera);
+
+    const EcsStruct *mesh = ecs_get(world, ecs_entity(Mesh), EcsStruct);
+    const EcsStruct *camera = ecs_get(world, ecs_entity(Camera), EcsStruct);
+    test_assert(mesh != NULL);
+    test_assert(camera != NULL);
+
+    EcsMember *mesh_members = ecs_vector_first(mesh->members, EcsMember);
+    EcsMember *camera_members = ecs_vector_first(camera->members, EcsMember);
+
+    /* Anonymous collection types with the same definition are shared */
+    test_assert(mesh_members[0].type == camera_members[0].type);
+    test_assert(mesh_members[1].type == camera_members[1].type);
+
+    {
+    Camera value = {{1, 2, 3}, NULL};
+    char *str = ecs_ptr_to_str(world, ecs_entity(Camera), &value);
+    test_str(str, "{position = [1, 2, 3], children = nullptr}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_to_str_buf() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Line);
+
+    {
+    Line value = {{10, 20}, {30, 40}};
+    char buf[64];
+    ecs_size_t len = ecs_ptr_to_str_buf(
+        world, ecs_entity(Line), &value, buf, sizeof(buf));
+    test_int(len, 51);
+    test_str(buf, "{start = {x = 10, y = 20}, stop = {x = 30, y = 40}}");
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_to_str_buf_overflow() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    Point value = {10, 20};
+    char buf[8];
+    ecs_size_t len = ecs_ptr_to_str_buf(
+        world, ecs_entity(Point), &value, buf, sizeof(buf));
+    test_int(len, 16);
+    test_str(buf, "{x = 10");
+    }
+
+    ecs_fini(world);
+}
+
+static
+int test_write(
+    void *ctx,
+    const char *str,
+    ecs_size_t len)
+{
+    ecs_strbuf_appendstrn(ctx, str, len);
+    return 0;
+}
+
+void Struct_struct_to_sink() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Line);
+
+    {
+    Line value = {{10, 20}, {30, 40}};
+    ecs_strbuf_t str = ECS_STRBUF_INIT;
+    char buf[8];
+
+    /* Small buffer so output is forwarded to the action multiple times */
+    ecs_meta_sink_t sink = ecs_meta_sink_action(
+        test_write, &str, buf, sizeof(buf));
+    test_int(ecs_ptr_to_sink(world, ecs_entity(Line), &value, &sink), 0);
+    test_int(sink.written, 51);
+
+    char *result = ecs_strbuf_get(&str);
+    test_str(result, "{start = {x = 10, y = 20}, stop = {x = 30, y = 40}}");
+    ecs_os_free(result);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_world_to_str_stream() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Target);
+
+    ecs_entity_t e1 = ecs_set(world, 0, EcsName, {"e1"});
+    ecs_set(world, e1, Point, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, EcsName, {"e2"});
+    ecs_set(world, e2, Point, {30, 40});
+    ecs_set(world, e2, Target, {e1});
+
+    ecs_strbuf_t str = ECS_STRBUF_INIT;
+    char buf[16];
+    ecs_meta_sink_t sink = ecs_meta_sink_action(
+        test_write, &str, buf, sizeof(buf));
+    test_int(ecs_world_to_str_stream(world, &sink), 0);
+    test_assert(sink.name_cache == NULL);
+
+    char *result = ecs_strbuf_get(&str);
+    test_assert(result != NULL);
+    test_assert(strstr(result, 
+        "e1: {\n"
+        "    Point: {x = 10, y = 20}\n"
+        "}") != NULL);
+    test_assert(strstr(result, 
+        "e2: {\n"
+        "    Point: {x = 30, y = 40}\n"
+        "    Target: {entity = e1}\n"
+        "}") != NULL);
+    ecs_os_free(result);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_redefine_two_worlds() {
+    ecs_world_t *world_1 = ecs_init();
+    ecs_world_t *world_2 = ecs_init();
+
+    {
+    ecs_world_t *world = world_1;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, Point);
+    }
+
+    {
+    ecs_world_t *world = world_2;
+    ECS_IMPORT(world, FlecsMeta);
+    ECS_META(world, Point);
+
+    /* Redefining a type only affects the world it is defined in */
+    ecs_set(world, ecs_entity(Point), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Point),
+        .alignment = ECS_ALIGNOF(Point),
+        .descriptor = "{int32_t a; int32_t b;}"
+    });
+    }
+
+    Point value = {10, 20};
+
+    ecs_entity_t point_1 = ecs_lookup(world_1, "Point");
+    ecs_entity_t point_2 = ecs_lookup(world_2, "Point");
+
+    {
+    char *str = ecs_ptr_to_str(world_1, point_1, &value);
+    test_str(str, "{x = 10, y = 20}");
+    ecs_os_free(str);
+    }
+
+    {
+    char *str = ecs_ptr_to_str(world_2, point_2, &value);
+    test_str(str, "{a = 10, b = 20}");
+    ecs_os_free(str);
+    }
+
+    /* Deleting a world does not affect the other world */
+    ecs_fini(world_1);
+
+    {
+    char *str = ecs_ptr_to_str(world_2, point_2, &value);
+    test_str(str, "{a = 10, b = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world_2);
+}
+
+void Struct_struct_redefine_nested() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Line), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_bool(ser->has_floats, false);
+
+    /* Line inlines the ops of Point, and must be serialized again */
+    ecs_set(world, ecs_entity(Point), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Point),
+        .alignment = ECS_ALIGNOF(Point),
+        .descriptor = "{float a; float b;}"
+    });
+
+    ser = ecs_get(world, ecs_entity(Line), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_bool(ser->has_floats, true);
+
+    Line value = {{0}};
+    float *f = (float*)&value;
+    f[0] = 1; f[1] = 2; f[2] = 3; f[3] = 4;
+
+    char *str = ecs_ptr_to_str(world, ecs_entity(Line), &value);
+    test_str(str, "{start = {a = 1.0, b = 2.0}, stop = {a = 3.0, b = 4.0}}");
+    ecs_os_free(str);
+
+    ecs_fini(world);
+}
+
+void Struct_struct_underscore_member() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Underscore);
+
+    {
+    Underscore value = {10, 20};
+    char *str = ecs_ptr_to_str(world, ecs_entity(Underscore), &value);
+    test_str(str, "{_x = 10, __y = 20}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_array_to_str_empty() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    {
+    char *str = ecs_array_to_str(world, ecs_entity(Point), NULL, 0);
+    test_str(str, "[]");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+void Struct_struct_entity_to_str_empty() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    {
+    ecs_entity_t e = ecs_new(world, 0);
+    char *str = ecs_entity_to_str(world, e);
+    test_str(str, "{\n}");
+    ecs_os_free(str);
+    }
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Node, {
+    int32_t value;
+    ecs_vector(Node) children;
+});
+
+void Struct_struct_recursive() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Node);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(Node), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_bool(ser->is_pod, false);
+    test_bool(ser->owns_heap, true);
+    test_int(ser->max_depth, ECS_META_MAX_SCOPE_DEPTH - 1);
+
+    {
+    Node value = {1, NULL};
+    Node *child = ecs_vector_add(&value.children, Node);
+    *child = (Node){2, NULL};
+
+    char *str = ecs_ptr_to_str(world, ecs_entity(Node), &value);
+    test_str(str, 
+        "{value = 1, children = [{value = 2, children = nullptr}]}");
+    ecs_os_free(str);
+
+    ecs_vector_free(value.children);
+    }
+
+    ecs_fini(world);
+}
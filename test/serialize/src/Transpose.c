@@ -0,0 +1,155 @@
+#include <test.h>
+
+ECS_STRUCT(Point, {
+    int32_t x;
+    int32_t y;
+});
+
+ECS_STRUCT(BoolInt, {
+    bool a;
+    int32_t b;
+});
+
+ECS_STRUCT(Line, {
+    Point start;
+    Point stop;
+    uint8_t color;
+});
+
+void Transpose_packed() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+
+    ecs_size_t sizes[2];
+    test_int(ecs_meta_soa_layout(world, ecs_entity(Point), sizes, 2), 2);
+    test_int(sizes[0], 4);
+    test_int(sizes[1], 4);
+
+    Point points[] = {{10, 20}, {30, 40}, {50, 60}};
+    int32_t x[3], y[3];
+    void *soa[] = {x, y};
+
+    test_int(ecs_meta_transpose_to_soa(
+        world, ecs_entity(Point), points, 3, soa), 0);
+    test_int(x[0], 10);
+    test_int(x[1], 30);
+    test_int(x[2], 50);
+    test_int(y[0], 20);
+    test_int(y[1], 40);
+    test_int(y[2], 60);
+
+    Point result[3] = {{0}};
+    test_int(ecs_meta_transpose_from_soa(
+        world, ecs_entity(Point), result, 3, soa), 0);
+    test_assert(!memcmp(points, result, sizeof(points)));
+
+    ecs_fini(world);
+}
+
+void Transpose_padded() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, BoolInt);
+
+    ecs_size_t sizes[2];
+    test_int(ecs_meta_soa_layout(world, ecs_entity(BoolInt), sizes, 2), 2);
+    test_int(sizes[0], 1);
+    test_int(sizes[1], 4);
+
+    BoolInt values[] = {{true, 10}, {false, 20}};
+    bool a[2];
+    int32_t b[2];
+    void *soa[] = {a, b};
+
+    test_int(ecs_meta_transpose_to_soa(
+        world, ecs_entity(BoolInt), values, 2, soa), 0);
+    test_bool(a[0], true);
+    test_bool(a[1], false);
+    test_int(b[0], 10);
+    test_int(b[1], 20);
+
+    BoolInt result[2] = {{0}};
+    test_int(ecs_meta_transpose_from_soa(
+        world, ecs_entity(BoolInt), result, 2, soa), 0);
+    test_bool(result[0].a, true);
+    test_int(result[0].b, 10);
+    test_bool(result[1].a, false);
+    test_int(result[1].b, 20);
+
+    ecs_fini(world);
+}
+
+void Transpose_nested() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, Line);
+
+    /* Nested structs are flattened */
+    test_int(ecs_meta_soa_layout(world, ecs_entity(Line), NULL, 0), 5);
+
+    Line lines[] = {{{1, 2}, {3, 4}, 5}, {{6, 7}, {8, 9}, 10}};
+    int32_t x1[2], y1[2], x2[2], y2[2];
+    uint8_t color[2];
+    void *soa[] = {x1, y1, x2, y2, color};
+
+    test_int(ecs_meta_transpose_to_soa(
+        world, ecs_entity(Line), lines, 2, soa), 0);
+    test_int(x1[0], 1);
+    test_int(x1[1], 6);
+    test_int(y1[0], 2);
+    test_int(y1[1], 7);
+    test_int(x2[0], 3);
+    test_int(x2[1], 8);
+    test_int(y2[0], 4);
+    test_int(y2[1], 9);
+    test_int(color[0], 5);
+    test_int(color[1], 10);
+
+    Line result[2];
+    memset(result, 0, sizeof(result));
+    test_int(ecs_meta_transpose_from_soa(
+        world, ecs_entity(Line), result, 2, soa), 0);
+    test_int(result[1].start.x, 6);
+    test_int(result[1].stop.y, 9);
+    test_int(result[1].color, 10);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(NamedPoint, {
+    char *name;
+    int32_t x;
+    int32_t y;
+});
+
+void Transpose_owning() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, NamedPoint);
+
+    /* Bytewise copies would share the strings, so the type is rejected */
+    test_int(ecs_meta_soa_layout(world, ecs_entity(NamedPoint), NULL, 0), -1);
+
+    NamedPoint points[] = {{"Foo", 10, 20}};
+    char *name[1];
+    int32_t x[1], y[1];
+    void *soa[] = {name, x, y};
+
+    test_int(ecs_meta_transpose_to_soa(
+        world, ecs_entity(NamedPoint), points, 1, soa), -1);
+    test_int(ecs_meta_transpose_from_soa(
+        world, ecs_entity(NamedPoint), points, 1, soa), -1);
+    test_str(points[0].name, "Foo");
+
+    ecs_fini(world);
+}
@@ -315,3 +315,106 @@ void Vector_vector_vector_empty() {
     ecs_fini(world);
 }
 
+
+void Vector_vector_redefine_element() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, VectorPoint);
+
+    ecs_vector_t *value = ecs_vector_from_array(
+        Point, 2, ((Point[]){{10, 20}, {30, 40}}));
+
+    {
+    char *str = ecs_ptr_to_str(world, ecs_entity(VectorPoint), &value);
+    test_str(str, "[{x = 10, y = 20}, {x = 30, y = 40}]");
+    ecs_os_free(str);
+    }
+
+    /* Vector type uses the ops of the new element definition */
+    ecs_set(world, ecs_entity(Point), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Point),
+        .alignment = ECS_ALIGNOF(Point),
+        .descriptor = "{int32_t a; int32_t b;}"
+    });
+
+    {
+    char *str = ecs_ptr_to_str(world, ecs_entity(VectorPoint), &value);
+    test_str(str, "[{a = 10, b = 20}, {a = 30, b = 40}]");
+    ecs_os_free(str);
+    }
+
+    ecs_vector_free(value);
+
+    ecs_fini(world);
+}
+
+void Vector_vector_serialize_no_write() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Point);
+    ECS_META(world, VectorPoint);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(VectorPoint), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+
+    /* Reading values must not write to the ops, which are shared between
+     * threads */
+    int32_t count = ecs_vector_count(ser->ops);
+    ecs_type_op_t *ops = ecs_vector_first(ser->ops, ecs_type_op_t);
+    ecs_type_op_t *copy = ecs_os_malloc(ECS_SIZEOF(ecs_type_op_t) * count);
+    ecs_os_memcpy(copy, ops, ECS_SIZEOF(ecs_type_op_t) * count);
+
+    ecs_vector_t *value = ecs_vector_from_array(
+        Point, 2, ((Point[]){{10, 20}, {30, 40}}));
+    char *str = ecs_ptr_to_str(world, ecs_entity(VectorPoint), &value);
+    test_str(str, "[{x = 10, y = 20}, {x = 30, y = 40}]");
+    ecs_os_free(str);
+
+    test_assert(!memcmp(copy, ops, sizeof(ecs_type_op_t) * (size_t)count));
+
+    ecs_os_free(copy);
+    ecs_vector_free(value);
+
+    ecs_fini(world);
+}
+
+ECS_STRUCT(Handle, {
+    int64_t id;
+});
+
+ECS_VECTOR(VectorHandle, Handle);
+
+void Vector_vector_redefine_element_traits() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMeta);
+
+    ECS_META(world, Handle);
+    ECS_META(world, VectorHandle);
+
+    const EcsMetaTypeSerializer *ser = ecs_get(
+        world, ecs_entity(VectorHandle), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_bool(ser->has_entities, false);
+
+    /* Traits of the vector are updated with the traits of the element */
+    ecs_set(world, ecs_entity(Handle), EcsMetaType, {
+        .kind = EcsStructType,
+        .size = sizeof(Handle),
+        .alignment = ECS_ALIGNOF(Handle),
+        .descriptor = "{ecs_entity_t e;}"
+    });
+
+    ser = ecs_get(world, ecs_entity(VectorHandle), EcsMetaTypeSerializer);
+    test_assert(ser != NULL);
+    test_bool(ser->has_entities, true);
+
+    ecs_fini(world);
+}
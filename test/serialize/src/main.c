@@ -26,23 +26,42 @@ void Primitive_float(void);
 void Primitive_double(void);
 void Primitive_string(void);
 void Primitive_entity(void);
+void Primitive_float_shortest(void);
+void Primitive_double_shortest(void);
 
 // Testsuite 'Struct'
 void Struct_struct(void);
 void Struct_nested_struct(void);
 void Struct_struct_bool_i32(void);
 void Struct_struct_i32_bool(void);
+void Struct_struct_array_to_str(void);
+void Struct_struct_iter_to_str(void);
+void Struct_struct_redefine(void);
+void Struct_struct_two_worlds(void);
+void Struct_struct_shared_collection_types(void);
+void Struct_struct_to_str_buf(void);
+void Struct_struct_to_str_buf_overflow(void);
+void Struct_struct_to_sink(void);
+void Struct_struct_world_to_str_stream(void);
+void Struct_struct_redefine_two_worlds(void);
+void Struct_struct_redefine_nested(void);
+void Struct_struct_underscore_member(void);
+void Struct_struct_array_to_str_empty(void);
+void Struct_struct_entity_to_str_empty(void);
+void Struct_struct_recursive(void);
 
 // Testsuite 'Enum'
 void Enum_enum(void);
 void Enum_enum_explicit_values(void);
 void Enum_enum_invalid_value(void);
+void Enum_enum_sparse_values(void);
 
 // Testsuite 'Bitmask'
 void Bitmask_bitmask_1(void);
 void Bitmask_bitmask_2(void);
 void Bitmask_bitmask_3(void);
 void Bitmask_bitmask_0_value(void);
+void Bitmask_bitmask_compound(void);
 
 // Testsuite 'Array'
 void Array_array_bool(void);
@@ -56,6 +75,7 @@ void Array_array_array_int(void);
 void Array_array_array_string(void);
 void Array_array_array_struct(void);
 void Array_array_array_nested_struct(void);
+void Array_struct_array_int_size(void);
 
 // Testsuite 'Vector'
 void Vector_vector_bool(void);
@@ -71,6 +91,9 @@ void Vector_vector_empty(void);
 void Vector_vector_vector_empty(void);
 void Vector_vector_null(void);
 void Vector_vector_vector_null(void);
+void Vector_vector_redefine_element(void);
+void Vector_vector_serialize_no_write(void);
+void Vector_vector_redefine_element_traits(void);
 
 // Testsuite 'Map'
 void Map_map_bool_bool(void);
@@ -86,6 +109,72 @@ void Map_map_int_array_int(void);
 void Map_map_int_vector_int(void);
 void Map_map_int_map_int_bool(void);
 
+// Testsuite 'Binary'
+void Binary_i32(void);
+void Binary_struct(void);
+void Binary_struct_w_padding(void);
+void Binary_struct_w_string(void);
+void Binary_null_string(void);
+void Binary_vector_int(void);
+void Binary_vector_string(void);
+void Binary_struct_w_vector(void);
+void Binary_map_int_string(void);
+void Binary_truncated(void);
+void Binary_trusted(void);
+void Binary_view(void);
+void Binary_vector_count_too_large(void);
+
+// Testsuite 'Transpose'
+void Transpose_packed(void);
+void Transpose_padded(void);
+void Transpose_nested(void);
+void Transpose_owning(void);
+
+// Testsuite 'Registry'
+void Registry_load(void);
+void Registry_load_w_vector(void);
+void Registry_meta_after_load(void);
+void Registry_load_invalid(void);
+void Registry_load_conflict(void);
+void Registry_load_members(void);
+
+// Testsuite 'Optimizer'
+void Optimizer_struct(void);
+void Optimizer_padded_struct(void);
+void Optimizer_array_struct(void);
+void Optimizer_array_padded_struct(void);
+void Optimizer_struct_w_padded_array(void);
+
+// Testsuite 'Compare'
+void Compare_struct(void);
+void Compare_padded_array(void);
+void Compare_string_vector(void);
+void Compare_float_zero(void);
+void Compare_float_nan(void);
+void Compare_float_column(void);
+
+// Testsuite 'Lifecycle'
+void Lifecycle_copy(void);
+void Lifecycle_move(void);
+void Lifecycle_delete(void);
+void Lifecycle_fini(void);
+void Lifecycle_redefine(void);
+void Lifecycle_world_context(void);
+
+// Testsuite 'Diff'
+void Diff_unchanged(void);
+void Diff_single_member(void);
+void Diff_string_member(void);
+void Diff_vector_member(void);
+void Diff_vector_count_too_large(void);
+
+// Testsuite 'Parser'
+void Parser_setup(void);
+void Parser_struct_dynamic_array(void);
+void Parser_struct_dynamic_array_w_space(void);
+void Parser_struct_array_size_1(void);
+void Parser_struct_long_identifiers(void);
+
 bake_test_case Primitive_testcases[] = {
     {
         "bool",
@@ -154,6 +243,14 @@ bake_test_case Primitive_testcases[] = {
     {
         "entity",
         Primitive_entity
+    },
+    {
+        "float_shortest",
+        Primitive_float_shortest
+    },
+    {
+        "double_shortest",
+        Primitive_double_shortest
     }
 };
 
@@ -173,6 +270,66 @@ bake_test_case Struct_testcases[] = {
     {
         "struct_i32_bool",
         Struct_struct_i32_bool
+    },
+    {
+        "struct_array_to_str",
+        Struct_struct_array_to_str
+    },
+    {
+        "struct_iter_to_str",
+        Struct_struct_iter_to_str
+    },
+    {
+        "struct_redefine",
+        Struct_struct_redefine
+    },
+    {
+        "struct_two_worlds",
+        Struct_struct_two_worlds
+    },
+    {
+        "struct_shared_collection_types",
+        Struct_struct_shared_collection_types
+    },
+    {
+        "struct_to_str_buf",
+        Struct_struct_to_str_buf
+    },
+    {
+        "struct_to_str_buf_overflow",
+        Struct_struct_to_str_buf_overflow
+    },
+    {
+        "struct_to_sink",
+        Struct_struct_to_sink
+    },
+    {
+        "struct_world_to_str_stream",
+        Struct_struct_world_to_str_stream
+    },
+    {
+        "struct_redefine_two_worlds",
+        Struct_struct_redefine_two_worlds
+    },
+    {
+        "struct_redefine_nested",
+        Struct_struct_redefine_nested
+    },
+    {
+        "struct_underscore_member",
+        Struct_struct_underscore_member
+    },
+    {
+        "struct_array_to_str_empty",
+        Struct_struct_array_to_str_empty
+    },
+    {
+        "struct_entity_to_str_empty",
+        Struct_struct_entity_to_str_empty
+    },
+    {
+        "struct_recursive",
+        Struct_struct_recursive
     }
 };
 
@@ -188,6 +345,10 @@ bake_test_case Enum_testcases[] = {
     {
         "enum_invalid_value",
         Enum_enum_invalid_value
+    },
+    {
+        "enum_sparse_values",
+        Enum_enum_sparse_values
     }
 };
 
@@ -207,6 +368,10 @@ bake_test_case Bitmask_testcases[] = {
     {
         "bitmask_0_value",
         Bitmask_bitmask_0_value
+    },
+    {
+        "bitmask_compound",
+        Bitmask_bitmask_compound
     }
 };
 
@@ -254,6 +419,10 @@ bake_test_case Array_testcases[] = {
     {
         "array_array_nested_struct",
         Array_array_array_nested_struct
+    },
+    {
+        "struct_array_int_size",
+        Array_struct_array_int_size
     }
 };
 
@@ -309,6 +478,18 @@ bake_test_case Vector_testcases[] = {
     {
         "vector_vector_null",
         Vector_vector_vector_null
+    },
+    {
+        "vector_redefine_element",
+        Vector_vector_redefine_element
+    },
+    {
+        "vector_serialize_no_write",
+        Vector_vector_serialize_no_write
+    },
+    {
+        "vector_redefine_element_traits",
+        Vector_vector_redefine_element_traits
     }
 };
 
@@ -363,47 +544,267 @@ bake_test_case Map_testcases[] = {
     }
 };
 
+bake_test_case Binary_testcases[] = {
+    {
+        "i32",
+        Binary_i32
+    },
+    {
+        "struct",
+        Binary_struct
+    },
+    {
+        "struct_w_padding",
+        Binary_struct_w_padding
+    },
+    {
+        "struct_w_string",
+        Binary_struct_w_string
+    },
+    {
+        "null_string",
+        Binary_null_string
+    },
+    {
+        "vector_int",
+        Binary_vector_int
+    },
+    {
+        "vector_string",
+        Binary_vector_string
+    },
+    {
+        "struct_w_vector",
+        Binary_struct_w_vector
+    },
+    {
+        "map_int_string",
+        Binary_map_int_string
+    },
+    {
+        "truncated",
+        Binary_truncated
+    },
+    {
+        "trusted",
+        Binary_trusted
+    },
+    {
+        "view",
+        Binary_view
+    },
+    {
+        "vector_count_too_large",
+        Binary_vector_count_too_large
+    }
+};
+
+bake_test_case Transpose_testcases[] = {
+    {
+        "packed",
+        Transpose_packed
+    },
+    {
+        "padded",
+        Transpose_padded
+    },
+    {
+        "nested",
+        Transpose_nested
+    },
+    {
+        "owning",
+        Transpose_owning
+    }
+};
+
+bake_test_case Registry_testcases[] = {
+    {
+        "load",
+        Registry_load
+    },
+    {
+        "load_w_vector",
+        Registry_load_w_vector
+    },
+    {
+        "meta_after_load",
+        Registry_meta_after_load
+    },
+    {
+        "load_invalid",
+        Registry_load_invalid
+    },
+    {
+        "load_conflict",
+        Registry_load_conflict
+    },
+    {
+        "load_members",
+        Registry_load_members
+    }
+};
+
+bake_test_case Optimizer_testcases[] = {
+    {
+        "struct",
+        Optimizer_struct
+    },
+    {
+        "padded_struct",
+        Optimizer_padded_struct
+    },
+    {
+        "array_struct",
+        Optimizer_array_struct
+    },
+    {
+        "array_padded_struct",
+        Optimizer_array_padded_struct
+    },
+    {
+        "struct_w_padded_array",
+        Optimizer_struct_w_padded_array
+    }
+};
+
+bake_test_case Compare_testcases[] = {
+    {
+        "struct",
+        Compare_struct
+    },
+    {
+        "padded_array",
+        Compare_padded_array
+    },
+    {
+        "string_vector",
+        Compare_string_vector
+    },
+    {
+        "float_zero",
+        Compare_float_zero
+    },
+    {
+        "float_nan",
+        Compare_float_nan
+    },
+    {
+        "float_column",
+        Compare_float_column
+    }
+};
+
+bake_test_case Lifecycle_testcases[] = {
+    {
+        "copy",
+        Lifecycle_copy
+    },
+    {
+        "move",
+        Lifecycle_move
+    },
+    {
+        "delete",
+        Lifecycle_delete
+    },
+    {
+        "fini",
+        Lifecycle_fini
+    },
+    {
+        "redefine",
+        Lifecycle_redefine
+    },
+    {
+        "world_context",
+        Lifecycle_world_context
+    }
+};
+
+bake_test_case Diff_testcases[] = {
+    {
+        "unchanged",
+        Diff_unchanged
+    },
+    {
+        "single_member",
+        Diff_single_member
+    },
+    {
+        "string_member",
+        Diff_string_member
+    },
+    {
+        "vector_member",
+        Diff_vector_member
+    },
+    {
+        "vector_count_too_large",
+        Diff_vector_count_too_large
+    }
+};
+
+bake_test_case Parser_testcases[] = {
+    {
+        "struct_dynamic_array",
+        Parser_struct_dynamic_array
+    },
+    {
+        "struct_dynamic_array_w_space",
+        Parser_struct_dynamic_array_w_space
+    },
+    {
+        "struct_array_size_1",
+        Parser_struct_array_size_1
+    },
+    {
+        "struct_long_identifiers",
+        Parser_struct_long_identifiers
+    }
+};
+
 static bake_test_suite suites[] = {
     {
         "Primitive",
         NULL,
         NULL,
-        17,
+        19,
         Primitive_testcases
     },
     {
         "Struct",
         NULL,
         NULL,
-        4,
+        19,
         Struct_testcases
     },
     {
         "Enum",
         NULL,
         NULL,
-        3,
+        4,
         Enum_testcases
     },
     {
         "Bitmask",
         NULL,
         NULL,
-        4,
+        5,
         Bitmask_testcases
     },
     {
         "Array",
         NULL,
         NULL,
-        11,
+        12,
         Array_testcases
     },
     {
         "Vector",
         NULL,
         NULL,
-        13,
+        16,
         Vector_testcases
     },
     {
@@ -412,10 +813,66 @@ static bake_test_suite suites[] = {
         NULL,
         12,
         Map_testcases
+    },
+    {
+        "Binary",
+        NULL,
+        NULL,
+        13,
+        Binary_testcases
+    },
+    {
+        "Transpose",
+        NULL,
+        NULL,
+        4,
+        Transpose_testcases
+    },
+    {
+        "Registry",
+        NULL,
+        NULL,
+        6,
+        Registry_testcases
+    },
+    {
+        "Optimizer",
+        NULL,
+        NULL,
+        5,
+        Optimizer_testcases
+    },
+    {
+        "Compare",
+        NULL,
+        NULL,
+        6,
+        Compare_testcases
+    },
+    {
+        "Lifecycle",
+        NULL,
+        NULL,
+        6,
+        Lifecycle_testcases
+    },
+    {
+        "Diff",
+        NULL,
+        NULL,
+        5,
+        Diff_testcases
+    },
+    {
+        "Parser",
+        Parser_setup,
+        NULL,
+        4,
+        Parser_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
     ut_init(argv[0]);
-    return bake_test_run("test", argc, argv, suites, 7);
+    return bake_test_run("test", argc, argv, suites, 15);
 }